@@ -315,7 +315,7 @@ static SignalVector* __stub_sv(SignalVector* sv)
     stub_sv->buffer_size = calloc(stub_sv->count, sizeof(uint32_t));
     stub_sv->reset_called = calloc(stub_sv->count, sizeof(bool));
     stub_sv->mime_type = calloc(stub_sv->count, sizeof(const char*));
-    stub_sv->ncodec = calloc(stub_sv->count, sizeof(NCODEC*));
+    stub_sv->ncodec = calloc(1, NCODEC_ARRAY_SIZE(stub_sv->count));
 
     for (uint32_t i = 0; i < stub_sv->count; i++) {
         stub_sv->signal[i] = sv->signal[i];
@@ -459,8 +459,8 @@ int simmock_step(SimMock* mock, bool assert_rc)
             for (uint32_t i = 0; i < mock->sv_signal->count; i++) {
                 model->sm_signal[i].signal->val = mock->sv_signal->scalar[i];
             }
-            controller_transform_to_model(
-                model->mfc_signal, model->sm_signal, mip->lua_state);
+            controller_transform_to_model(model->mfc_signal,
+                model->sm_signal, mip->lua_state, mock->model_time);
         }
         /* Copy binary from simmock->binary_rx. */
         if (mock->sv_network_rx && mock->sv_network_tx) {
@@ -192,6 +192,11 @@ DLL_PRIVATE SignalMap* adapter_get_signal_map(AdapterModel* am,
 DLL_PRIVATE void adapter_dump_debug(Adapter* adapter, SimulationSpec* sim);
 DLL_PRIVATE void adapter_model_dump_debug(AdapterModel* am, const char* name);
 
+/* affinity.c */
+DLL_PRIVATE int adapter_parse_cpu_list(
+    const char* cpus, bool* cpu, size_t count);
+DLL_PRIVATE int adapter_set_cpu_affinity(const char* cpus);
+
 /* adapter_msg.c */
 DLL_PUBLIC AdapterVTable* adapter_create_msg_vtable(void);
 
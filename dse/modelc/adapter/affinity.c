@@ -0,0 +1,139 @@
+// Copyright 2026 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#if defined(__linux__)
+#define _GNU_SOURCE
+#endif
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <dse/logger.h>
+#include <dse/platform.h>
+#include <dse/modelc/adapter/adapter.h>
+#if defined(__linux__)
+#include <sched.h>
+#include <pthread.h>
+#endif
+
+
+/**
+adapter_parse_cpu_list
+======================
+
+Parse a CPU list (e.g. "0-3,8,10-11") into an array of CPU flags.
+
+Parameters
+----------
+cpus (const char*)
+: The CPU list.
+
+cpu (bool*)
+: Array of CPU flags, the flag of each CPU in the list is set.
+
+count (size_t)
+: The number of elements in the `cpu` array.
+
+Returns
+-------
+0
+: The CPU list was parsed.
+
+-EINVAL
+: The CPU list is empty or contains an invalid token or range.
+
+-ERANGE
+: The CPU list contains a CPU which is outside the `cpu` array.
+*/
+int adapter_parse_cpu_list(const char* cpus, bool* cpu, size_t count)
+{
+    if (cpus == NULL || cpu == NULL) return -EINVAL;
+    memset(cpu, 0, count * sizeof(bool));
+
+    bool        found = false;
+    const char* p = cpus;
+    while (*p == ',' || *p == ' ') p++;
+    while (*p) {
+        char* end = NULL;
+        if (*p < '0' || *p > '9') return -EINVAL;
+        long first = strtol(p, &end, 10);
+        if (end == p) return -EINVAL;
+        long last = first;
+        p = end;
+        if (*p == '-') {
+            p++;
+            if (*p < '0' || *p > '9') return -EINVAL;
+            last = strtol(p, &end, 10);
+            if (end == p || last < first) return -EINVAL;
+            p = end;
+        }
+        if (*p != '\0' && *p != ',' && *p != ' ') return -EINVAL;
+        if ((unsigned long)last >= count) return -ERANGE;
+        for (long c = first; c <= last; c++) {
+            cpu[c] = true;
+        }
+        found = true;
+        while (*p == ',' || *p == ' ') p++;
+    }
+    if (found == false) return -EINVAL;
+    return 0;
+}
+
+
+/**
+adapter_set_cpu_affinity
+========================
+
+Pin the calling thread to the specified CPU list (e.g. "0-3,8"). Memory which
+is subsequently first touched by the thread (i.e. signal vectors and the
+direct index map) is then placed on the NUMA node of those CPUs.
+
+Parameters
+----------
+cpus (const char*)
+: The CPU list. When NULL (or empty) the affinity is not changed.
+
+Returns
+-------
+0
+: The affinity was set (or not requested).
+
+-EINVAL
+: The CPU list could not be parsed.
+
+-ERANGE
+: The CPU list contains a CPU which is not supported (>= CPU_SETSIZE).
+
+-ENOSYS
+: CPU affinity is not supported on this platform.
+*/
+int adapter_set_cpu_affinity(const char* cpus)
+{
+    if (cpus == NULL || strlen(cpus) == 0) return 0;
+
+#if defined(__linux__)
+    bool cpu[CPU_SETSIZE];
+    int  rc = adapter_parse_cpu_list(cpus, cpu, CPU_SETSIZE);
+    if (rc) {
+        log_error("CPU affinity: invalid CPU list (%s)", cpus);
+        return rc;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int i = 0; i < CPU_SETSIZE; i++) {
+        if (cpu[i]) CPU_SET(i, &set);
+    }
+    rc = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set);
+    if (rc) {
+        log_error("CPU affinity: pthread_setaffinity_np failed (rc=%d)", rc);
+        return -rc;
+    }
+    log_notice("CPU affinity: %s", cpus);
+    return 0;
+#else
+    log_notice("CPU affinity: not supported on this platform (%s)", cpus);
+    return -ENOSYS;
+#endif
+}
@@ -34,6 +34,7 @@ void controller_destroy(SimulationSpec* sim)
     if (controller == NULL) return;
 
     if (controller->adapter) adapter_destroy(controller->adapter);
+    hashmap_destroy(&controller->libraries);
 
     free(mip->controller);
     mip->controller = NULL;
@@ -55,6 +56,7 @@ int controller_init(Endpoint* endpoint, SimulationSpec* sim)
 
     Controller* controller = mip->controller;
     controller->stop_request = false;
+    hashmap_init(&controller->libraries);
 
     log_notice("Create the Adapter object ...");
     controller->adapter = adapter_create(endpoint);
@@ -100,8 +102,9 @@ static int __marshal__adapter2model(void* _mfc, void* _spec)
     }
     SignalMap* sm = mfc->signal_map;
 
-    if (mfc->signal_value_double) {
-        controller_transform_to_model(mfc, sm, mip->lua_state);
+    if (mfc->signal_value_double && spec->mf->schedule.due) {
+        controller_transform_to_model(
+            mfc, sm, mip->lua_state, am->model_time);
     }
     if (spec->dir == MARSHAL_ADAPTER2MODEL_SCALAR_ONLY) return 0;
 
@@ -168,16 +171,25 @@ static int __marshal__model_function(void* _mf, void* _spec)
 {
     ModelFunction*         mf = _mf;
     ControllerMarshalSpec* spec = _spec;
+    ModelInstancePrivate*  mip = spec->mi->private;
+    AdapterModel*          am = mip->adapter_model;
     int                    rc = 0;
+
+    spec->mf = mf;
     switch (spec->dir) {
     case MARSHAL_ADAPTER2MODEL:
     case MARSHAL_ADAPTER2MODEL_SCALAR_ONLY:
+        /* Scalars are only marshalled when the function is due, binary
+        data is always marshalled (accumulates until the function is due). */
+        controller_model_function_due(mf, am->model_time, am->stop_time);
         rc = hashmap_iterator(
             &mf->channels, __marshal__adapter2model, false, spec);
         break;
     case MARSHAL_MODEL2ADAPTER:
     case MARSHAL_MODEL2ADAPTER_SCALAR_ONLY:
     case MARSHAL_MODEL2ADAPTER_BINARY_ONLY:
+        /* Skip functions which were not called in the previous step. */
+        if (mf->schedule.active && mf->schedule.due == false) break;
         rc = hashmap_iterator(
             &mf->channels, __marshal__model2adapter, false, spec);
         break;
@@ -196,7 +208,7 @@ static int __marshal__model(ControllerModel* cm, void* spec)
 
 void marshal_model(ModelInstanceSpec* mi, ControllerMarshalDir dir)
 {
-    ControllerMarshalSpec md = { dir, mi };
+    ControllerMarshalSpec md = { .dir = dir, .mi = mi };
     ModelInstancePrivate* mip = mi->private;
     ControllerModel*      cm = mip->controller_model;
     __marshal__model(cm, &md);
@@ -342,6 +354,7 @@ void controller_run(SimulationSpec* sim)
 
     /* ModelRegister (etc). */
     controller_bus_ready(sim);
+    controller_pacing_init(&controller->pacing, sim);
 
     /* ModelReady, ModelStart, do_step(). */
     while (true) {
@@ -352,7 +365,9 @@ void controller_run(SimulationSpec* sim)
         }
         int rc = controller_step(sim);
         if (rc != 0) break;
+        controller_pacing_wait(&controller->pacing);
     }
+    controller_pacing_report(&controller->pacing);
 }
 
 
@@ -8,6 +8,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <time.h>
 #include <dse/modelc/adapter/adapter.h>
 #include <dse/modelc/adapter/transport/endpoint.h>
 #include <dse/clib/collections/hashmap.h>
@@ -33,8 +34,31 @@ typedef struct SignalTransform {
         } vector;
     } function;
     struct TimingTransform {
-        float interval;
-        float phase;
+        /* Each element is disabled when set to 0 (default). */
+        double interval; /* Sample-and-hold interval. */
+        double phase;    /* Sample-and-hold phase (offset to interval). */
+        double delay;    /* Transport delay. */
+        double lag;      /* First-order lag, time constant. */
+        struct TimingState {
+            /* Delay line (ring buffer), sized from delay and step size. */
+            double*  delay_line;
+            uint32_t delay_length;
+            uint32_t delay_pos;
+            double   delay_value;
+            /* Sample-and-hold. */
+            bool     sample;
+            double   hold_value;
+            /* First-order lag. */
+            double   lag_alpha;
+            double   lag_prev;
+            double   lag_value;
+            /* Step tracking (state advances once per step). */
+            double   step_size;
+            double   time;
+            bool     active;
+            /* Value presented to the model (after all transforms). */
+            double   model_value;
+        } state;
     } timing;
 } SignalTransform;
 
@@ -68,6 +92,14 @@ typedef struct ModelFunction {
     const char* name;
     double      step_size;
 
+    /* Rate scheduling, the function is called when its step_size elapses. */
+    struct {
+        double model_time; /* Time of the last call (start of period). */
+        double next_time;  /* Time when the function is next due. */
+        bool   due;        /* Function is due in the current step. */
+        bool   active;
+    } schedule;
+
     /* Collection of ModelFunctionChannel, Key is channel_name. */
     HashMap channels;
 } ModelFunction;
@@ -86,13 +118,43 @@ typedef struct ControllerModel {
 } ControllerModel;
 
 
+#define PACING_HISTOGRAM_BINS 16
+
+
+typedef struct ControllerPacing {
+    bool            enabled;
+    uint64_t        step_ns;
+    uint64_t        busy_wait_ns; /* Spin for the final part of each step. */
+    struct timespec epoch;        /* Wall-clock time of step 0. */
+    uint64_t        step_count;
+    /* Statistics (lateness of wakeup relative to the step boundary). */
+    struct {
+        uint64_t steps;
+        uint64_t overrun; /* Steps where the deadline had already passed. */
+        uint64_t lateness_max_ns;
+        uint64_t lateness_sum_ns;
+        /* Log2 bins in microseconds: [0] < 1us, [1] < 2us, ... */
+        uint64_t histogram[PACING_HISTOGRAM_BINS];
+    } stats;
+} ControllerPacing;
+
+
+typedef struct ControllerLibrary {
+    void*       handle;  // Not owned, each ControllerModel has a reference.
+    ModelVTable vtable;
+} ControllerLibrary;
+
+
 typedef struct Controller {
-    bool            stop_request;
+    bool             stop_request;
     /* Adapter/Endpoint objects. */
-    Adapter*        adapter;
+    Adapter*         adapter;
     /* Model configuration info: specific to a simulation. */
-    SimulationSpec* simulation;
-    HashMap         controller_models;  // index by model instance name.
+    SimulationSpec*  simulation;
+    HashMap          controller_models;  // index by model instance name.
+    HashMap          libraries;  // ControllerLibrary, index by dynlib path.
+    /* Soft real-time pacing of the run loop. */
+    ControllerPacing pacing;
 } Controller;
 
 
@@ -108,6 +170,7 @@ typedef enum ControllerMarshalDir {
 typedef struct ControllerMarshalSpec {
     ControllerMarshalDir dir;
     ModelInstanceSpec*   mi;
+    ModelFunction*       mf;
 } ControllerMarshalSpec;
 
 
@@ -127,6 +190,12 @@ DLL_PRIVATE int controller_register_model_function(
 DLL_PRIVATE ModelFunction* controller_get_model_function(
     ModelInstanceSpec* model_instance, const char* model_function_name);
 
+/* Rate scheduling of Model Functions (model_function.c). */
+DLL_PRIVATE bool controller_model_function_due(
+    ModelFunction* mf, double model_time, double stop_time);
+DLL_PRIVATE void controller_model_function_advance(
+    ModelFunction* mf, double stop_time);
+
 /* These control the operation of the Model. */
 DLL_PRIVATE void controller_run(SimulationSpec* sim);
 DLL_PRIVATE void controller_bus_ready(SimulationSpec* sim);
@@ -144,6 +213,15 @@ DLL_PRIVATE void marshal_model(ModelInstanceSpec* mi, ControllerMarshalDir dir);
 DLL_PRIVATE int controller_load_models(SimulationSpec* sim);
 
 
+/* pacing.c */
+DLL_PRIVATE void controller_pacing_init(
+    ControllerPacing* pacing, SimulationSpec* sim);
+DLL_PRIVATE void controller_pacing_record(
+    ControllerPacing* pacing, uint64_t lateness_ns);
+DLL_PRIVATE void controller_pacing_wait(ControllerPacing* pacing);
+DLL_PRIVATE void controller_pacing_report(ControllerPacing* pacing);
+
+
 /* step.c */
 DLL_PRIVATE int step_model(ModelInstanceSpec* mi, double* model_time);
 DLL_PRIVATE int sim_step_models(SimulationSpec* sim, double* model_time);
@@ -154,8 +232,11 @@ DLL_PUBLIC void model_function_destroy(ModelFunction* model_function);
 
 
 /* transform.c */
-DLL_PRIVATE void controller_transform_to_model(
-    ModelFunctionChannel* mfc, SignalMap* sm, lua_State* L);
+DLL_PRIVATE void controller_transform_init(
+    ModelFunctionChannel* mfc, double step_size);
+DLL_PRIVATE void controller_transform_destroy(ModelFunctionChannel* mfc);
+DLL_PRIVATE void controller_transform_to_model(ModelFunctionChannel* mfc,
+    SignalMap* sm, lua_State* L, double model_time);
 DLL_PRIVATE void controller_transform_from_model(
     ModelFunctionChannel* mfc, SignalMap* sm, lua_State* L);
 
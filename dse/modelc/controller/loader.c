@@ -2,9 +2,14 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#if defined(__linux__)
+#define _GNU_SOURCE
+#endif
 #include <errno.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <stddef.h>
+#include <stdbool.h>
 #include <assert.h>
 #include <dlfcn.h>
 #include <dse/testing.h>
@@ -22,11 +27,52 @@ extern int        __model_gw_step__(
 extern void __model_gw_destroy__(ModelDesc* m);
 
 
+static bool _isolate_globals(ModelInstanceSpec* mi)
+{
+    /* Model Instance annotation: isolate (i.e. private copy of globals). */
+    bool      isolate = false;
+    YamlNode* a = dse_yaml_find_node(mi->spec, "annotations");
+    if (a) dse_yaml_get_bool(a, "isolate", &isolate);
+    return isolate;
+}
+
+
+static void* _dlopen_model(const char* model_path, bool isolate)
+{
+    if (isolate) {
+#if defined(__linux__)
+        /* New link-map namespace, the library globals are not shared with
+        other instances. Namespaces are a limited resource (glibc: 16).
+
+        NOTE: dependencies of the library are also loaded into the new
+        namespace, including a second copy of libmodelc. That copy has its
+        own globals (e.g. log level, trace configuration), only the log level
+        is aligned here. Objects passed via the Model API (ModelDesc, Signal
+        Vectors) remain owned by this runtime. */
+        log_notice("Loading dynamic model (isolated): %s ...", model_path);
+        void* handle = dlmopen(LM_ID_NEWLM, model_path, RTLD_NOW | RTLD_LOCAL);
+        if (handle) {
+            uint8_t* log_level = dlsym(handle, "__log_level__");
+            if (log_level && log_level != &__log_level__) {
+                *log_level = __log_level__;
+            }
+        }
+        return handle;
+#else
+        log_notice("Isolated loading not supported on this platform!");
+#endif
+    }
+    log_notice("Loading dynamic model: %s ...", model_path);
+    return dlopen(model_path, RTLD_NOW | RTLD_LOCAL);
+}
+
+
 static int controller_load_model(ModelInstanceSpec* mi, SimulationSpec* sim)
 {
     assert(mi);
     ModelInstancePrivate* mip = mi->private;
     ControllerModel*      cm = mip->controller_model;
+    Controller*           controller = controller_object_ref(sim);
     assert(cm);
     const char* dynlib_filename = mi->model_definition.full_path;
 
@@ -34,10 +80,29 @@ static int controller_load_model(ModelInstanceSpec* mi, SimulationSpec* sim)
 
     if (dynlib_filename) {
         char* model_path = dse_path_cat(sim->sim_path, dynlib_filename);
-        log_notice("Loading dynamic model: %s ...", model_path);
-        cm->handle = dlopen(model_path, RTLD_NOW | RTLD_LOCAL);
-        free(model_path);
+        bool  isolate = _isolate_globals(mi);
+
+        /* Shared libraries are loaded once, instances reuse the resolved
+        symbols (unless isolation is requested). Each instance holds its own
+        reference to the library (i.e. the dlopen() reference count), which
+        is released by dlclose() when that instance is destroyed. */
+        ControllerLibrary* lib =
+            isolate ? NULL : hashmap_get(&controller->libraries, model_path);
+        if (lib) {
+            log_notice("Using loaded dynamic model: %s", model_path);
+            cm->handle = dlopen(model_path, RTLD_NOW | RTLD_LOCAL);
+            free(model_path);
+            if (cm->handle == NULL) {
+                log_notice("ERROR: dlopen call: %s", dlerror());
+                goto error_dl;
+            }
+            cm->vtable = lib->vtable;
+            return 0;
+        }
+
+        cm->handle = _dlopen_model(model_path, isolate);
         if (cm->handle == NULL) {
+            free(model_path);
             log_notice("ERROR: dlopen call: %s", dlerror());
             goto error_dl;
         }
@@ -51,6 +116,15 @@ static int controller_load_model(ModelInstanceSpec* mi, SimulationSpec* sim)
         cm->vtable.destroy = dlsym(cm->handle, MODEL_DESTROY_FUNC_NAME);
         log_notice("Loading symbol: %s ... %s", MODEL_DESTROY_FUNC_NAME,
             cm->vtable.destroy ? "ok" : "not found");
+
+        /* Cache the library symbols (the handle is not owned by the cache). */
+        if (isolate == false) {
+            lib = calloc(1, sizeof(ControllerLibrary));
+            lib->handle = cm->handle;
+            lib->vtable = cm->vtable;
+            hashmap_set_alt(&controller->libraries, model_path, lib);
+        }
+        free(model_path);
     } else if (dse_yaml_find_node(
                    mi->model_definition.doc, "spec/runtime/gateway")) {
         log_notice("Using gateway symbols: ...");
@@ -58,6 +58,36 @@ ModelFunction* controller_get_model_function(
 }
 
 
+bool controller_model_function_due(
+    ModelFunction* mf, double model_time, double stop_time)
+{
+    assert(mf);
+
+    if (mf->schedule.active == false) {
+        /* First period starts at the current model time. */
+        mf->schedule.model_time = model_time;
+        mf->schedule.next_time = model_time + mf->step_size;
+        mf->schedule.active = true;
+    }
+    double epsilon = mf->step_size * 0.01;
+    mf->schedule.due = (stop_time + epsilon >= mf->schedule.next_time);
+    return mf->schedule.due;
+}
+
+
+void controller_model_function_advance(ModelFunction* mf, double stop_time)
+{
+    assert(mf);
+
+    double epsilon = mf->step_size * 0.01;
+    mf->schedule.model_time = stop_time;
+    if (mf->step_size <= 0) return;
+    while (mf->schedule.next_time <= stop_time + epsilon) {
+        mf->schedule.next_time += mf->step_size;
+    }
+}
+
+
 const char* controller_get_signal_annotation(
     ModelFunctionChannel* mfc, const char* signal_name, const char* name)
 {
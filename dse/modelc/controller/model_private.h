@@ -17,6 +17,12 @@
 #define MI_RUNTIME_LUA_MCL_NAME "lua"
 
 
+/* Allocation size of the NCodec array of a binary SignalVector (sv->ncodec),
+the NCodec pointers are followed by a byte for each signal which is set when
+NCodec creation failed (see signal_codec()). */
+#define NCODEC_ARRAY_SIZE(count) ((count) * (sizeof(void*) + sizeof(uint8_t)))
+
+
 typedef struct ModelInstancePrivate {
     ControllerModel* controller_model;
     AdapterModel*    adapter_model;
@@ -29,7 +35,8 @@ typedef struct ModelInstancePrivate {
     MclDestroy  mcl_destroy_func;
 
     /* PDU Network objects (locate by NCodec pointer/address). */
-    Vector pdunet; /* PduNetworkDesc* */
+    Vector pdunet;      /* PduNetworkDesc* */
+    void*  pdunet_pool; /* PduNetPool, NULL = sequential processing. */
 } ModelInstancePrivate;
 
 
@@ -42,5 +49,19 @@ DLL_PRIVATE void mcl_builtin_model_destroy(ModelDesc* model);
 DLL_PRIVATE const char* controller_get_signal_annotation(
     ModelFunctionChannel* mfc, const char* signal_name, const char* name);
 
+/* pdunet_pool.c */
+DLL_PRIVATE int  pdunet_pool_create(ModelInstanceSpec* mi);
+DLL_PRIVATE void pdunet_pool_rx(void* pool);
+DLL_PRIVATE void pdunet_pool_tx(void* pool, double model_time);
+DLL_PRIVATE void pdunet_pool_destroy(void* pool);
+
+/* trace_pcap.c */
+DLL_PRIVATE int  ncodec_pcap_open(
+     const char* path, uint16_t link_type, const char* name);
+DLL_PRIVATE void ncodec_pcap_write(int if_id, double timestamp, bool rx,
+    const uint8_t* header, size_t header_len, const uint8_t* data,
+    size_t data_len);
+DLL_PRIVATE void ncodec_pcap_close(void);
+
 
 #endif  // DSE_MODELC_CONTROLLER_MODEL_PRIVATE_H_
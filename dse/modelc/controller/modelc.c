@@ -9,6 +9,7 @@
 #include <errno.h>
 #include <unistd.h>
 #include <string.h>
+#include <math.h>
 #include <dlfcn.h>
 #include <dse/testing.h>
 #include <dse/logger.h>
@@ -61,6 +62,8 @@ static void _destroy_model_instances(SimulationSpec* sim)
         }
 
         /* PDU Net. */
+        pdunet_pool_destroy(mip->pdunet_pool);
+        mip->pdunet_pool = NULL;
         for (size_t i = 0; i < vector_len(&mip->pdunet); i++) {
             PduNetworkDesc* net = NULL;
             vector_at(&mip->pdunet, i, &net);
@@ -192,19 +195,24 @@ int modelc_configure_model(
     }
     model_instance->model_definition.name = model_name;
     /* Path. */
+    const char* selector[] = { "metadata/name" };
+    const char* value[] = { model_name };
     node = dse_yaml_find_node(mi_node, "model/metadata/annotations/path");
     if (node && node->scalar) {
         model_instance->model_definition.path = node->scalar;
-        /* Load and add the Model Definition to the doc list. */
-        char* md_file =
-            _dse_path_cat(model_instance->model_definition.path, "model.yaml");
-        log_notice("Load YAML File: %s", md_file);
-        args->yaml_doc_list = dse_yaml_load_file(md_file, args->yaml_doc_list);
-        free(md_file);
+        /* Load and add the Model Definition to the doc list, only once for
+        all instances of the same Model. */
+        if (dse_yaml_find_doc_in_doclist(args->yaml_doc_list, "Model",
+                selector, value, 1) == NULL) {
+            char* md_file = _dse_path_cat(
+                model_instance->model_definition.path, "model.yaml");
+            log_notice("Load YAML File: %s", md_file);
+            args->yaml_doc_list =
+                dse_yaml_load_file(md_file, args->yaml_doc_list);
+            free(md_file);
+        }
     }
     /* Model Definition. */
-    const char* selector[] = { "metadata/name" };
-    const char* value[] = { model_name };
     md_doc = dse_yaml_find_doc_in_doclist(
         args->yaml_doc_list, "Model", selector, value, 1);
     if (md_doc) {
@@ -412,6 +420,35 @@ error_clean_up:
     return errno;
 }
 
+static double _model_function_step_size(
+    SimulationSpec* sim, ModelInstanceSpec* mi)
+{
+    /* Model Instance annotation, fallback to Model Definition annotation. */
+    const char* value = NULL;
+    YamlNode*   a = dse_yaml_find_node(mi->spec, "annotations");
+    if (a) value = dse_yaml_get_scalar(a, "step_size");
+    if (value == NULL) {
+        a = dse_yaml_find_node(
+            mi->model_definition.doc, "metadata/annotations");
+        if (a) value = dse_yaml_get_scalar(a, "step_size");
+    }
+    if (value == NULL) return sim->step_size;
+
+    /* Must be a multiple of the simulation step size. */
+    double step_size = atof(value);
+    double epsilon = sim->step_size * 0.01;
+    double n = round(step_size / sim->step_size);
+    if (n < 1 || fabs(step_size - n * sim->step_size) > epsilon) {
+        log_error("Model step_size (%f) not a multiple of simulation step "
+                  "size (%f), using simulation step size!",
+            step_size, sim->step_size);
+        return sim->step_size;
+    }
+    log_notice("  Model Function Step Size: %f (%s)", step_size, mi->name);
+    return step_size;
+}
+
+
 int modelc_model_create(
     SimulationSpec* sim, ModelInstanceSpec* mi, ModelVTable* model_vtable)
 {
@@ -423,7 +460,8 @@ int modelc_model_create(
         log_error("Model has no " MODEL_STEP_FUNC_NAME "() function");
         return -errno;
     }
-    int rc = _model_function_register(mi, MODEL_STEP_FUNC_NAME, sim->step_size);
+    int rc = _model_function_register(
+        mi, MODEL_STEP_FUNC_NAME, _model_function_step_size(sim, mi));
     if (rc != 0) {
         if (errno == 0) errno = rc;
         log_error("Model function registration failed!");
@@ -474,42 +512,56 @@ int modelc_model_create(
     for (SignalVector* sv_p = sv; sv_p->name; sv_p++) {
         if (sv_p->is_binary == false) continue;
         for (uint32_t i = 0; i < sv_p->count; i++) {
-            /* NCodec */
-            void* ncodec = sv_p->ncodec[i];
-            if (ncodec == NULL) continue;
-
             /* PDU Net annotation */
             const char* pdunet_name =
                 signal_annotation(sv_p, i, "pdunet", NULL);
-            if (pdunet_name) {
-                /* Network labels. */
-                SchemaLabel net_labels[] = {
-                    { .name = "signal", .value = sv_p->signal[i] },
-                    { .name = "pdunet", .value = pdunet_name },
+            if (pdunet_name == NULL) continue;
+
+            /* NCodec (created on first use). */
+            void* ncodec = signal_codec(sv_p, i);
+            if (ncodec == NULL) continue;
+
+            /* Network labels. */
+            SchemaLabel net_labels[] = {
+                { .name = "signal", .value = sv_p->signal[i] },
+                { .name = "pdunet", .value = pdunet_name },
+                {},
+            };
+            /* SignalGroup Labels. */
+            CLEANUP_P(void, sg_labels) = NULL;
+            const char* channel_name =
+                signal_annotation(sv_p, i, "channel", NULL);
+            if (channel_name) {
+                SchemaLabel labels[] = {
+                    { .name = "model", .value = mi->name },
+                    { .name = "channel", .value = channel_name },
                     {},
                 };
-                /* SignalGroup Labels. */
-                CLEANUP_P(void, sg_labels) = NULL;
-                const char* channel_name =
-                    signal_annotation(sv_p, i, "channel", NULL);
-                if (channel_name) {
-                    SchemaLabel labels[] = {
-                        { .name = "model", .value = mi->name },
-                        { .name = "channel", .value = channel_name },
-                        {},
-                    };
-                    sg_labels = malloc(sizeof(labels));
-                    memcpy(sg_labels, labels, sizeof(labels));
-                }
-                /* Create the PDU Network. */
-                PduNetworkDesc* net = pdunet_create(
-                    mi, ncodec, net_labels, sg_labels, NULL, NULL);
-                if (net) {
-                    vector_push(&mip->pdunet, &net);
-                }
+                sg_labels = malloc(sizeof(labels));
+                memcpy(sg_labels, labels, sizeof(labels));
+            }
+            /* Create the PDU Network. */
+            PduNetworkDesc* net = pdunet_create(
+                mi, ncodec, net_labels, sg_labels, NULL, NULL);
+            if (net) {
+                vector_push(&mip->pdunet, &net);
             }
         }
     }
+    /* Link PDU routes (between PDU Networks). */
+    for (size_t i = 0; i < vector_len(&mip->pdunet); i++) {
+        PduNetworkDesc* net = NULL;
+        vector_at(&mip->pdunet, i, &net);
+        for (size_t j = 0; j < vector_len(&mip->pdunet); j++) {
+            PduNetworkDesc* source = NULL;
+            vector_at(&mip->pdunet, j, &source);
+            if (source != net) pdunet_route_link(net, source);
+        }
+    }
+    /* PDU Network worker pool (optional). */
+    if (pdunet_pool_create(mi) != 0) {
+        log_error("PDU Net Pool: not created, processing is sequential");
+    }
 
     /* Call create (if it exists). */
     if (model_desc->vtable.create) {
@@ -608,6 +660,27 @@ int modelc_run(SimulationSpec* sim, bool run_async)
     assert(sim);
     errno = 0;
 
+    /* CPU affinity, applied before the Endpoint, Controller and Models are
+    created so that their allocations are first touched on the pinned (NUMA)
+    node. */
+    for (ModelInstanceSpec* _instptr = sim->instance_list;
+        _instptr && _instptr->name; _instptr++) {
+        YamlNode*   a = dse_yaml_find_node(_instptr->spec, "annotations");
+        const char* cpus = a ? dse_yaml_get_scalar(a, "cpu_affinity") : NULL;
+        if (cpus) {
+            /* Stacked models share the Controller thread, first wins.
+               Platforms without affinity support continue unpinned. */
+            int rc = adapter_set_cpu_affinity(cpus);
+            if (rc && rc != -ENOSYS) {
+                errno = -rc;
+                log_error("Could not set CPU affinity of model instance %s",
+                    _instptr->name);
+                return errno;
+            }
+            break;
+        }
+    }
+
     /* Create Endpoint object. */
     log_notice("Create the Endpoint object ...");
     Endpoint* endpoint = _create_endpoint(sim);
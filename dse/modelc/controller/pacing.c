@@ -0,0 +1,182 @@
+// Copyright 2026 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <time.h>
+#include <errno.h>
+#include <assert.h>
+#include <dse/testing.h>
+#include <dse/logger.h>
+#include <dse/clib/util/yaml.h>
+#include <dse/modelc/runtime.h>
+#include <dse/modelc/controller/controller.h>
+
+
+#define NSEC_PER_SEC 1000000000ULL
+#define PACING_CLOCK CLOCK_MONOTONIC
+
+
+static inline uint64_t _ts_to_ns(struct timespec ts)
+{
+    return (uint64_t)ts.tv_sec * NSEC_PER_SEC + (uint64_t)ts.tv_nsec;
+}
+
+
+static inline struct timespec _ns_to_ts(uint64_t ns)
+{
+    return (struct timespec){
+        .tv_sec = (time_t)(ns / NSEC_PER_SEC),
+        .tv_nsec = (long)(ns % NSEC_PER_SEC),
+    };
+}
+
+
+static inline uint64_t _now_ns(void)
+{
+    struct timespec ts = {};
+    clock_gettime(PACING_CLOCK, &ts);
+    return _ts_to_ns(ts);
+}
+
+
+static void _sleep_until(uint64_t deadline_ns)
+{
+    struct timespec ts = _ns_to_ts(deadline_ns);
+#if defined(_WIN32)
+    uint64_t now_ns = _now_ns();
+    if (deadline_ns <= now_ns) return;
+    ts = _ns_to_ts(deadline_ns - now_ns);
+    while (nanosleep(&ts, &ts) == -1 && errno == EINTR) {
+    }
+#else
+    while (clock_nanosleep(PACING_CLOCK, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+    }
+#endif
+}
+
+
+/* Soft real-time pacing of the Controller run loop, configured by the Stack:
+
+    spec:
+      runtime:
+        realtime:
+          enabled: true
+          busy_wait: 0.0001  # Busy-wait for the final 100us of each step.
+
+   When enabled, each step is aligned to a wall-clock step boundary
+   (i.e. epoch + n * step_size). */
+void controller_pacing_init(ControllerPacing* pacing, SimulationSpec* sim)
+{
+    assert(pacing);
+    assert(sim);
+
+    *pacing = (ControllerPacing){};
+    if (sim->spec == NULL) return;
+    YamlNode* n = dse_yaml_find_node(sim->spec, "spec/runtime/realtime");
+    if (n == NULL) return;
+
+    bool   enabled = false;
+    double busy_wait = 0.0;
+    dse_yaml_get_bool(n, "enabled", &enabled);
+    dse_yaml_get_double(n, "busy_wait", &busy_wait);
+    if (enabled == false) return;
+    if (sim->step_size <= 0) return;
+
+    pacing->enabled = true;
+    pacing->step_ns = (uint64_t)(sim->step_size * NSEC_PER_SEC + 0.5);
+    if (busy_wait > 0) {
+        pacing->busy_wait_ns = (uint64_t)(busy_wait * NSEC_PER_SEC + 0.5);
+    }
+    log_notice("Realtime Pacing:");
+    log_notice("  Step: %" PRIu64 " ns", pacing->step_ns);
+    log_notice("  Busy Wait: %" PRIu64 " ns", pacing->busy_wait_ns);
+}
+
+
+/* Record the lateness of a step wakeup relative to its step boundary. */
+void controller_pacing_record(ControllerPacing* pacing, uint64_t lateness_ns)
+{
+    assert(pacing);
+
+    uint64_t lateness_us = lateness_ns / 1000;
+    uint32_t bin = 0;
+    while (lateness_us && bin < PACING_HISTOGRAM_BINS - 1) {
+        lateness_us >>= 1;
+        bin++;
+    }
+    pacing->stats.histogram[bin]++;
+    pacing->stats.steps++;
+    pacing->stats.lateness_sum_ns += lateness_ns;
+    if (lateness_ns > pacing->stats.lateness_max_ns) {
+        pacing->stats.lateness_max_ns = lateness_ns;
+    }
+}
+
+
+/* Wait until the next step boundary, the first call sets the epoch. When a
+   step overruns its boundary the wait is skipped, and if the overrun exceeds a
+   full step the epoch is shifted (i.e. no catch-up burst of steps). The
+   lateness of an overrun is recorded against the original deadline. */
+void controller_pacing_wait(ControllerPacing* pacing)
+{
+    assert(pacing);
+    if (pacing->enabled == false) return;
+
+    uint64_t now_ns = _now_ns();
+    if (pacing->step_count == 0) {
+        pacing->epoch = _ns_to_ts(now_ns);
+    }
+    pacing->step_count++;
+    uint64_t deadline_ns =
+        _ts_to_ns(pacing->epoch) + pacing->step_count * pacing->step_ns;
+
+    if (now_ns >= deadline_ns) {
+        pacing->stats.overrun++;
+        controller_pacing_record(pacing, now_ns - deadline_ns);
+        if (now_ns - deadline_ns > pacing->step_ns) {
+            /* Shift the epoch, the next step starts now. */
+            pacing->epoch =
+                _ns_to_ts(now_ns - pacing->step_count * pacing->step_ns);
+        }
+        return;
+    }
+
+    if (deadline_ns - now_ns > pacing->busy_wait_ns) {
+        _sleep_until(deadline_ns - pacing->busy_wait_ns);
+    }
+    do {
+        now_ns = _now_ns();
+    } while (now_ns < deadline_ns);
+    controller_pacing_record(pacing, now_ns - deadline_ns);
+}
+
+
+/* Log the pacing statistics (overruns and a jitter histogram). */
+void controller_pacing_report(ControllerPacing* pacing)
+{
+    assert(pacing);
+    if (pacing->enabled == false) return;
+    if (pacing->stats.steps == 0) return;
+
+    log_notice("Realtime Pacing Statistics:");
+    log_notice("  Steps: %" PRIu64, pacing->stats.steps);
+    log_notice("  Overrun: %" PRIu64, pacing->stats.overrun);
+    log_notice("  Lateness (avg): %" PRIu64 " ns",
+        pacing->stats.lateness_sum_ns / pacing->stats.steps);
+    log_notice(
+        "  Lateness (max): %" PRIu64 " ns", pacing->stats.lateness_max_ns);
+    log_notice("  Jitter Histogram:");
+    for (uint32_t i = 0; i < PACING_HISTOGRAM_BINS; i++) {
+        if (pacing->stats.histogram[i] == 0) continue;
+        if (i == PACING_HISTOGRAM_BINS - 1) {
+            log_notice("    >= %6u us : %" PRIu64, 1U << (i - 1),
+                pacing->stats.histogram[i]);
+        } else {
+            log_notice("    <  %6u us : %" PRIu64, 1U << i,
+                pacing->stats.histogram[i]);
+        }
+    }
+}
@@ -0,0 +1,325 @@
+// Copyright 2026 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <errno.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <dse/logger.h>
+#include <dse/clib/collections/vector.h>
+#include <dse/clib/util/yaml.h>
+#include <dse/modelc/controller/model_private.h>
+#include <dse/modelc/pdunet.h>
+#include <dse/modelc/model/pdunet/network.h>
+
+
+/*
+PDU Network Worker Pool
+=======================
+
+The PDU Networks of a Model Instance are independent objects (each with its
+own matrix, NCodec and binary signal) and may be processed (Rx and Tx phases)
+in parallel by a small pool of worker threads. The calling thread also takes
+work from the pool, and waits for all workers to complete (i.e. a barrier)
+before returning. PDU Networks which install Lua functions share the Lua
+state of the Model Instance, and PDU Networks which map the same SignalVector
+signals share those scalars; both are always processed by the calling thread.
+
+Configured with the Model Instance annotation `pdunet_workers` (the number of
+worker threads, default 0 = sequential processing).
+*/
+
+
+typedef enum {
+    PoolOpNone = 0,
+    PoolOpRx,
+    PoolOpTx,
+    PoolOpExit,
+} PoolOp;
+
+
+typedef struct PduNetPool {
+    /* PDU Networks. */
+    Vector parallel; /* PduNetworkDesc*, processed by any thread. */
+    Vector serial;   /* PduNetworkDesc*, processed by the calling thread. */
+    /* Workers. */
+    size_t     count;
+    pthread_t* threads;
+    /* Work (protected by lock). */
+    pthread_mutex_t lock;
+    pthread_cond_t  start;
+    pthread_cond_t  done;
+    uint64_t        generation;
+    PoolOp          op;
+    double          model_time;
+    size_t          next;    /* Next index into parallel. */
+    size_t          pending; /* Workers which have not completed the op. */
+} PduNetPool;
+
+
+static bool _runs_overlap(Vector* a, Vector* b)
+{
+    for (size_t i = 0; i < vector_len(a); i++) {
+        PduMarshalRun* x = vector_at(a, i, NULL);
+        for (size_t j = 0; j < vector_len(b); j++) {
+            PduMarshalRun* y = vector_at(b, j, NULL);
+            if (x->signal < y->signal + y->count &&
+                y->signal < x->signal + x->count) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+
+/* PDU Networks overlap when their marshal runs (Rx or Tx) map any of the same
+   SignalVector scalars. */
+static bool _net_overlap(PduNetworkDesc* a, PduNetworkDesc* b)
+{
+    if (a->msm.scalar == NULL || a->msm.scalar != b->msm.scalar) return false;
+    Vector* runs_a[] = { &a->msm.run_in, &a->msm.run_out };
+    Vector* runs_b[] = { &b->msm.run_in, &b->msm.run_out };
+    for (size_t i = 0; i < 2; i++) {
+        for (size_t j = 0; j < 2; j++) {
+            if (_runs_overlap(runs_a[i], runs_b[j])) return true;
+        }
+    }
+    return false;
+}
+
+
+static bool _net_serial(ModelInstancePrivate* mip, PduNetworkDesc* net)
+{
+    if (net->lua.installed) return true;
+    for (size_t i = 0; i < vector_len(&mip->pdunet); i++) {
+        PduNetworkDesc* other = NULL;
+        vector_at(&mip->pdunet, i, &other);
+        if (other == NULL || other == net) continue;
+        if (_net_overlap(net, other)) return true;
+    }
+    return false;
+}
+
+
+static void _process(PduNetPool* pool, PduNetworkDesc* net)
+{
+    switch (pool->op) {
+    case PoolOpRx:
+        pdunet_rx(net, NULL, NULL, NULL);
+        break;
+    case PoolOpTx:
+        pdunet_tx(net, NULL, NULL, NULL, pool->model_time);
+        break;
+    default:
+        break;
+    }
+}
+
+
+/* Process PDU Networks from the work queue, call with lock held. */
+static void _drain(PduNetPool* pool)
+{
+    while (pool->next < vector_len(&pool->parallel)) {
+        PduNetworkDesc* net = NULL;
+        vector_at(&pool->parallel, pool->next++, &net);
+        pthread_mutex_unlock(&pool->lock);
+        _process(pool, net);
+        pthread_mutex_lock(&pool->lock);
+    }
+}
+
+
+static void* _worker(void* arg)
+{
+    PduNetPool* pool = arg;
+    uint64_t    generation = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    while (1) {
+        while (pool->generation == generation) {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+        generation = pool->generation;
+        if (pool->op == PoolOpExit) break;
+        _drain(pool);
+        if (--pool->pending == 0) pthread_cond_signal(&pool->done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+
+static void _dispatch(PduNetPool* pool, PoolOp op, double model_time)
+{
+    pthread_mutex_lock(&pool->lock);
+    pool->op = op;
+    pool->model_time = model_time;
+    pool->next = 0;
+    pool->pending = pool->count;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    /* Serial PDU Networks (calling thread). */
+    for (size_t i = 0; i < vector_len(&pool->serial); i++) {
+        PduNetworkDesc* net = NULL;
+        vector_at(&pool->serial, i, &net);
+        _process(pool, net);
+    }
+
+    /* Parallel PDU Networks, then wait for the workers (barrier). */
+    pthread_mutex_lock(&pool->lock);
+    _drain(pool);
+    while (pool->pending) {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+
+/**
+pdunet_pool_create
+==================
+
+Create a worker pool for the PDU Networks of a Model Instance, if requested
+by the Model Instance annotation `pdunet_workers`.
+
+Parameters
+----------
+mi (ModelInstanceSpec*)
+: Model Instance object (PDU Networks already created).
+
+Returns
+-------
+0
+: The pool was created (or not requested).
+
+-errno
+: The pool could not be created, PDU Networks are processed sequentially.
+*/
+int pdunet_pool_create(ModelInstanceSpec* mi)
+{
+    ModelInstancePrivate* mip = mi->private;
+    unsigned int          workers = 0;
+    YamlNode*             a = dse_yaml_find_node(mi->spec, "annotations");
+    if (a) dse_yaml_get_uint(a, "pdunet_workers", &workers);
+    if (workers == 0 || vector_len(&mip->pdunet) < 2) return 0;
+
+    PduNetPool* pool = calloc(1, sizeof(PduNetPool));
+    if (pool == NULL) return -ENOMEM;
+    pool->parallel = vector_make(sizeof(PduNetworkDesc*), 4, NULL);
+    pool->serial = vector_make(sizeof(PduNetworkDesc*), 4, NULL);
+    for (size_t i = 0; i < vector_len(&mip->pdunet); i++) {
+        PduNetworkDesc* net = NULL;
+        vector_at(&mip->pdunet, i, &net);
+        if (net == NULL) continue;
+        if (_net_serial(mip, net)) {
+            vector_push(&pool->serial, &net);
+        } else {
+            vector_push(&pool->parallel, &net);
+        }
+    }
+    /* The calling thread also processes parallel PDU Networks. */
+    size_t count = vector_len(&pool->parallel);
+    if (vector_len(&pool->serial) == 0 && count) count--;
+    if (count > workers) count = workers;
+    if (count == 0) {
+        log_notice("PDU Net Pool: no parallel PDU Networks (%s)", mi->name);
+        pdunet_pool_destroy(pool);
+        return 0;
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    pool->threads = calloc(count, sizeof(pthread_t));
+    for (size_t i = 0; i < count; i++) {
+        int rc = pthread_create(&pool->threads[i], NULL, _worker, pool);
+        if (rc) {
+            log_error("PDU Net Pool: pthread_create failed (rc=%d)", rc);
+            break;
+        }
+        pool->count++;
+    }
+    log_notice("PDU Net Pool: %u workers, %u parallel, %u serial (%s)",
+        (unsigned)pool->count, (unsigned)vector_len(&pool->parallel),
+        (unsigned)vector_len(&pool->serial), mi->name);
+    mip->pdunet_pool = pool;
+    return 0;
+}
+
+
+/**
+pdunet_pool_rx
+==============
+
+Receive on all PDU Networks of the pool, returns when all are complete.
+
+Parameters
+----------
+pool (void*)
+: The PDU Network pool.
+*/
+void pdunet_pool_rx(void* pool)
+{
+    if (pool == NULL) return;
+    _dispatch(pool, PoolOpRx, 0.0);
+}
+
+
+/**
+pdunet_pool_tx
+==============
+
+Transmit on all PDU Networks of the pool, returns when all are complete.
+
+Parameters
+----------
+pool (void*)
+: The PDU Network pool.
+
+model_time (double)
+: The simulation time of the Tx.
+*/
+void pdunet_pool_tx(void* pool, double model_time)
+{
+    if (pool == NULL) return;
+    _dispatch(pool, PoolOpTx, model_time);
+}
+
+
+/**
+pdunet_pool_destroy
+===================
+
+Stop the workers and release the pool. The PDU Networks are not destroyed.
+
+Parameters
+----------
+pool (void*)
+: The PDU Network pool.
+*/
+void pdunet_pool_destroy(void* pool)
+{
+    PduNetPool* p = pool;
+    if (p == NULL) return;
+
+    if (p->threads) {
+        pthread_mutex_lock(&p->lock);
+        p->op = PoolOpExit;
+        p->generation++;
+        pthread_cond_broadcast(&p->start);
+        pthread_mutex_unlock(&p->lock);
+        for (size_t i = 0; i < p->count; i++) {
+            pthread_join(p->threads[i], NULL);
+        }
+        free(p->threads);
+        pthread_cond_destroy(&p->done);
+        pthread_cond_destroy(&p->start);
+        pthread_mutex_destroy(&p->lock);
+    }
+    vector_reset(&p->parallel);
+    vector_reset(&p->serial);
+    free(p);
+}
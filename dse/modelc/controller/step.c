@@ -22,28 +22,49 @@ typedef struct mf_step_data {
     ModelInstanceSpec* mi;
     double             model_time;
     double             stop_time;
+    uint32_t           due_count;
 } mf_step_data;
 
 
+static int _do_due_func(void* _mf, void* _step_data)
+{
+    ModelFunction* mf = _mf;
+    mf_step_data*  step_data = _step_data;
+
+    if (controller_model_function_due(
+            mf, step_data->model_time, step_data->stop_time)) {
+        step_data->due_count++;
+    }
+    return 0;
+}
+
+
 static int _do_step_func(void* _mf, void* _step_data)
 {
     ModelFunction* mf = _mf;
     mf_step_data*  step_data = _step_data;
     ModelDesc*     md = step_data->mi->model_desc;
 
+    /* Only call the function when its period has elapsed. */
+    if (mf->schedule.due == false) return 0;
+
+    /* Reposition NCodec streams, only those which were operated (i.e. the
+    stream position is not at 0). */
     for (SignalVector* sv = md->sv; sv && sv->name; sv++) {
+        if (sv->is_binary == false) continue;
         for (uint32_t i = 0; i < sv->count; i++) {
-            if (sv->is_binary == false) continue;
             if (sv->ncodec[i] == NULL) continue;
+            if (sv->ncodec_dirty && sv->ncodec_dirty[i] == false) continue;
             ncodec_seek(sv->ncodec[i], 0, NCODEC_SEEK_SET);
         }
     }
 
-    double model_time = step_data->model_time;
+    double model_time = mf->schedule.model_time;
     int    rc = md->vtable.step(md, &model_time, step_data->stop_time);
     if (rc)
         log_error(
             "Model Function %s:%s (rc=%d)", step_data->mi->name, mf->name, rc);
+    controller_model_function_advance(mf, step_data->stop_time);
 
     return 0;
 }
@@ -54,29 +75,48 @@ int step_model(ModelInstanceSpec* mi, double* model_time)
     ModelInstancePrivate* mip = mi->private;
     ControllerModel*      cm = mip->controller_model;
     AdapterModel*         am = mip->adapter_model;
+    HashMap*              mf_map = &cm->model_functions;
+
+    /* Determine which Model Functions are due in this step. When none are
+    due (i.e. a slower raster) the Model, including its PDU Networks, is idle
+    and binary data accumulates until the next due step. */
+    mf_step_data step_data = { mi, am->model_time, am->stop_time, 0 };
+    hashmap_iterator(mf_map, _do_due_func, false, &step_data);
+    if (step_data.due_count == 0) {
+        am->bench_steptime_ns = 0;
+        am->model_time = am->stop_time;
+        *model_time = am->model_time;
+        return 0;
+    }
 
     /* PDU Net - receive from network. */
-    for (size_t i = 0; i < vector_len(&mip->pdunet); i++) {
-        PduNetworkDesc* net = NULL;
-        vector_at(&mip->pdunet, i, &net);
-        if (net) {
-            pdunet_rx(net, NULL, NULL, NULL);
+    if (mip->pdunet_pool) {
+        pdunet_pool_rx(mip->pdunet_pool);
+    } else {
+        for (size_t i = 0; i < vector_len(&mip->pdunet); i++) {
+            PduNetworkDesc* net = NULL;
+            vector_at(&mip->pdunet, i, &net);
+            if (net) {
+                pdunet_rx(net, NULL, NULL, NULL);
+            }
         }
     }
 
     /* Step the Model (i.e. call registered Model Functions). */
-    mf_step_data    step_data = { mi, am->model_time, am->stop_time };
-    HashMap*        mf_map = &cm->model_functions;
     struct timespec stepcall_ts = get_timespec_now();
     int rc = hashmap_iterator(mf_map, _do_step_func, false, &step_data);
     am->bench_steptime_ns = get_elapsedtime_ns(stepcall_ts);
 
     /* PDU Net - send to network. */
-    for (size_t i = 0; i < vector_len(&mip->pdunet); i++) {
-        PduNetworkDesc* net = NULL;
-        vector_at(&mip->pdunet, i, &net);
-        if (net) {
-            pdunet_tx(net, NULL, NULL, NULL, am->model_time);
+    if (mip->pdunet_pool) {
+        pdunet_pool_tx(mip->pdunet_pool, am->model_time);
+    } else {
+        for (size_t i = 0; i < vector_len(&mip->pdunet); i++) {
+            PduNetworkDesc* net = NULL;
+            vector_at(&mip->pdunet, i, &net);
+            if (net) {
+                pdunet_tx(net, NULL, NULL, NULL, am->model_time);
+            }
         }
     }
 
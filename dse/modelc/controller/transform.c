@@ -2,7 +2,9 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include <stdlib.h>
 #include <stdbool.h>
+#include <math.h>
 #include <dse/testing.h>
 #include <dse/logger.h>
 #include <dse/modelc/adapter/adapter.h>
@@ -30,8 +32,113 @@ cleanup:
 }
 
 
-DLL_PRIVATE void controller_transform_to_model(
-    ModelFunctionChannel* mfc, SignalMap* sm, lua_State* L)
+static inline bool _timing_enabled(struct TimingTransform* t)
+{
+    return (t->delay > 0 || t->interval > 0 || t->lag > 0);
+}
+
+
+DLL_PRIVATE void controller_transform_init(
+    ModelFunctionChannel* mfc, double step_size)
+{
+    if (mfc->signal_transform == NULL) return;
+    if (step_size <= 0) step_size = MODEL_DEFAULT_STEP_SIZE;
+
+    for (uint32_t si = 0; si < mfc->signal_count; si++) {
+        struct TimingTransform* t = &mfc->signal_transform[si].timing;
+        if (_timing_enabled(t) == false) continue;
+
+        t->state = (struct TimingState){ .step_size = step_size };
+        if (t->delay > 0) {
+            /* Delay line holds one sample per step of delay. */
+            t->state.delay_length =
+                (uint32_t)((t->delay + (step_size * 0.01)) / step_size);
+            if (t->state.delay_length) {
+                t->state.delay_line =
+                    calloc(t->state.delay_length, sizeof(double));
+            }
+        }
+        if (t->lag > 0) {
+            /* Backward Euler, stable for any time constant. */
+            t->state.lag_alpha = step_size / (t->lag + step_size);
+        }
+    }
+}
+
+
+DLL_PRIVATE void controller_transform_destroy(ModelFunctionChannel* mfc)
+{
+    if (mfc->signal_transform == NULL) return;
+
+    for (uint32_t si = 0; si < mfc->signal_count; si++) {
+        struct TimingTransform* t = &mfc->signal_transform[si].timing;
+        free(t->state.delay_line);
+        t->state.delay_line = NULL;
+        t->state.delay_length = 0;
+    }
+}
+
+
+static inline bool _timing_sample(struct TimingTransform* t, double model_time)
+{
+    if (t->interval <= 0) return true;
+
+    double epsilon = t->state.step_size * 0.01;
+    if (model_time + epsilon < t->phase) return false;
+    double n = (model_time - t->phase) / t->interval;
+    return (fabs(n - round(n)) * t->interval) < epsilon;
+}
+
+
+static inline double _timing_transform(
+    struct TimingTransform* t, double value, double model_time)
+{
+    struct TimingState* s = &t->state;
+
+    /* The state advances once per step, repeated calls within a step (e.g.
+    sequential cosim) re-evaluate the current step with the newer value. */
+    if (s->active == false) {
+        for (uint32_t i = 0; i < s->delay_length; i++) {
+            s->delay_line[i] = value;
+        }
+        s->delay_value = value;
+        s->hold_value = value;
+        s->lag_prev = s->lag_value = value;
+        s->sample = _timing_sample(t, model_time);
+        s->time = model_time;
+        s->active = true;
+    } else if (fabs(model_time - s->time) > (s->step_size * 0.01)) {
+        if (s->delay_length) {
+            s->delay_pos = (s->delay_pos + 1) % s->delay_length;
+            s->delay_value = s->delay_line[s->delay_pos];
+        }
+        s->sample = _timing_sample(t, model_time);
+        s->lag_prev = s->lag_value;
+        s->time = model_time;
+    }
+
+    /* Transport delay. */
+    if (s->delay_length) {
+        s->delay_line[s->delay_pos] = value;
+        value = s->delay_value;
+    }
+    /* Sample-and-hold. */
+    if (t->interval > 0) {
+        if (s->sample) s->hold_value = value;
+        value = s->hold_value;
+    }
+    /* First-order lag. */
+    if (t->lag > 0) {
+        s->lag_value = s->lag_prev + (value - s->lag_prev) * s->lag_alpha;
+        value = s->lag_value;
+    }
+
+    return value;
+}
+
+
+DLL_PRIVATE void controller_transform_to_model(ModelFunctionChannel* mfc,
+    SignalMap* sm, lua_State* L, double model_time)
 {
     if (mfc->signal_transform) {
         for (uint32_t si = 0; si < mfc->signal_count; si++) {
@@ -51,8 +158,14 @@ DLL_PRIVATE void controller_transform_to_model(
                 mfc->signal_transform[si].function.model.ref,
                 mfc->signal_value_double[si]);
 
-            /* Timing (phase/intercal effects). */
-            // TODO: Lua delay library.
+            /* Timing (delay/interval/phase/lag effects). */
+            if (mfc->signal_transform[si].timing.state.step_size > 0) {
+                mfc->signal_value_double[si] =
+                    _timing_transform(&mfc->signal_transform[si].timing,
+                        mfc->signal_value_double[si], model_time);
+                mfc->signal_transform[si].timing.state.model_value =
+                    mfc->signal_value_double[si];
+            }
         }
     } else {
         for (uint32_t si = 0; si < mfc->signal_count; si++) {
@@ -67,6 +180,15 @@ DLL_PRIVATE void controller_transform_from_model(
 {
     if (mfc->signal_transform) {
         for (uint32_t si = 0; si < mfc->signal_count; si++) {
+            /* Timing: a delayed/held value not modified by the model is not
+            reflected back to the signal vector. */
+            struct TimingState* ts = &mfc->signal_transform[si].timing.state;
+            if (ts->active &&
+                mfc->signal_value_double[si] == ts->model_value) {
+                sm[si].signal->final_val = sm[si].signal->val;
+                continue;
+            }
+
             /* Linear transform: value * factor + offset */
             if (mfc->signal_transform[si].linear.factor != 0) {
                 sm[si].signal->final_val =
@@ -82,9 +204,6 @@ DLL_PRIVATE void controller_transform_from_model(
             sm[si].signal->final_val = _call_lua_transform(L,
                 mfc->signal_transform[si].function.vector.ref,
                 sm[si].signal->final_val);
-
-            /* Timing (phase/intercal effects). */
-            // TODO: Lua delay library.
         }
     } else {
         for (uint32_t si = 0; si < mfc->signal_count; si++) {
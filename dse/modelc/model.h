@@ -248,16 +248,17 @@ typedef struct SignalVector {
     /* Annotation direct lookup. */
     void** annotation;
 
+    /* Binary signals, NCodec stream position not at 0 (may be NULL). */
+    bool* ncodec_dirty;
+
     /* Reserved. */
 #if defined(__x86_64__)
 #if __SIZEOF_POINTER__ == 8
-    uint64_t __reserved__[7];
+    uint64_t __reserved__[6];
 #else
-    uint32_t __reserved_4__;
     uint64_t __reserved__[7];
 #endif
 #elif defined(__i386__)
-    uint32_t __reserved_4__;
     uint64_t __reserved__[7];
 #endif
 } SignalVector;
@@ -274,6 +275,9 @@ DLL_PUBLIC int signal_reset(SignalVector* sv, uint32_t index);
 DLL_PUBLIC int signal_reset_called(
     SignalVector* sv, uint32_t index, bool* reset_called);
 DLL_PUBLIC int         signal_release(SignalVector* sv, uint32_t index);
+DLL_PUBLIC int         signal_reserve(
+    SignalVector* sv, uint32_t index, size_t len, uint8_t** data);
+DLL_PUBLIC int signal_commit(SignalVector* sv, uint32_t index, size_t len);
 DLL_PUBLIC void*       signal_codec(SignalVector* sv, uint32_t index);
 DLL_PUBLIC const char* signal_annotation(
     SignalVector* sv, uint32_t index, const char* name, void** node);
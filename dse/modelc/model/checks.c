@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <assert.h>
+#include <stddef.h>
 #include <dse/modelc/gateway.h>
 #include <dse/modelc/mcl.h>
 #include <dse/modelc/model.h>
@@ -28,6 +29,7 @@ __attribute__((unused)) static void __compile_time_checks(void)
     // char(*___)[sizeof(RuntimeModelDesc)] = 1;
 
     // char (*___)[sizeof(SignalVector)] = 1;
+    // char (*___)[offsetof(SignalVector, vtable)] = 1;
 
 #if defined(__x86_64__)
 #if __SIZEOF_POINTER__ == 8
@@ -43,6 +45,10 @@ __attribute__((unused)) static void __compile_time_checks(void)
     _Static_assert(sizeof(ModelCArguments) == 160, "Compatibility FAIL!");
     _Static_assert(sizeof(RuntimeModelDesc) == 272, "Compatibility FAIL!");
     _Static_assert(sizeof(SignalVector) == 256, "Compatibility FAIL!");
+    _Static_assert(
+        offsetof(SignalVector, vtable) == 128, "Compatibility FAIL!");
+    _Static_assert(
+        offsetof(SignalVector, ncodec_dirty) == 200, "Compatibility FAIL!");
 #else
     _Static_assert(sizeof(MclDesc) == 192, "Compatibility FAIL!");
     _Static_assert(sizeof(MarshalGroup) == 88, "Compatibility FAIL!");
@@ -56,6 +62,10 @@ __attribute__((unused)) static void __compile_time_checks(void)
     _Static_assert(sizeof(ModelCArguments) == 120, "Compatibility FAIL!");
     _Static_assert(sizeof(RuntimeModelDesc) == 200, "Compatibility FAIL!");
     _Static_assert(sizeof(SignalVector) == 160, "Compatibility FAIL!");
+    _Static_assert(
+        offsetof(SignalVector, vtable) == 64, "Compatibility FAIL!");
+    _Static_assert(
+        offsetof(SignalVector, ncodec_dirty) == 100, "Compatibility FAIL!");
 #endif
 #elif defined(__i386__)
     _Static_assert(sizeof(ModelGatewayDesc) == 60, "Compatibility FAIL!");
@@ -70,5 +80,9 @@ __attribute__((unused)) static void __compile_time_checks(void)
     _Static_assert(sizeof(ModelCArguments) == 112, "Compatibility FAIL!");
     _Static_assert(sizeof(RuntimeModelDesc) == 196, "Compatibility FAIL!");
     _Static_assert(sizeof(SignalVector) == 160, "Compatibility FAIL!");
+    _Static_assert(
+        offsetof(SignalVector, vtable) == 64, "Compatibility FAIL!");
+    _Static_assert(
+        offsetof(SignalVector, ncodec_dirty) == 100, "Compatibility FAIL!");
 #endif
 }
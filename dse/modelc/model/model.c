@@ -63,7 +63,10 @@ void model_function_destroy(ModelFunction* model_function)
                 free(_mfc->signal_names);
             }
             if (_mfc && _mfc->signal_map) free(_mfc->signal_map);
-            if (_mfc && _mfc->signal_transform) free(_mfc->signal_transform);
+            if (_mfc && _mfc->signal_transform) {
+                controller_transform_destroy(_mfc);
+                free(_mfc->signal_transform);
+            }
             if (_mfc && _mfc->signal_annotation) free(_mfc->signal_annotation);
         }
         hashmap_destroy(&model_function->channels);
@@ -112,18 +115,29 @@ typedef struct SignalHandlerData {
 static SignalTransform* _parse_signal_transform(SchemaSignalObject* so)
 {
     YamlNode* linear_node = dse_yaml_find_node(so->data, "transform/linear");
-    if (linear_node == NULL) return NULL;
+    YamlNode* timing_node = dse_yaml_find_node(so->data, "transform/timing");
+    if (linear_node == NULL && timing_node == NULL) return NULL;
 
     /* Create an object for the transform. */
     SignalTransform* st = malloc(sizeof(SignalTransform));
-    *st = (SignalTransform){ .linear.factor = 1.0, .linear.offset = 0.0 };
-    dse_yaml_get_double(linear_node, "factor", &st->linear.factor);
-    dse_yaml_get_double(linear_node, "offset", &st->linear.offset);
-    /* Linear factor *CANNOT* be 0 ... the transform is effectively disabled. */
-    if (st->linear.factor == 0.0) {
-        log_notice("Signal (%s): linear transform factor configured as 0 "
-                   "(invalid value), transform disabled!",
-            so->signal);
+    *st = (SignalTransform){ .linear.factor = 0.0, .linear.offset = 0.0 };
+    if (linear_node) {
+        st->linear.factor = 1.0;
+        dse_yaml_get_double(linear_node, "factor", &st->linear.factor);
+        dse_yaml_get_double(linear_node, "offset", &st->linear.offset);
+        /* Linear factor *CANNOT* be 0 ... the transform is effectively
+         * disabled. */
+        if (st->linear.factor == 0.0) {
+            log_notice("Signal (%s): linear transform factor configured as 0 "
+                       "(invalid value), transform disabled!",
+                so->signal);
+        }
+    }
+    if (timing_node) {
+        dse_yaml_get_double(timing_node, "delay", &st->timing.delay);
+        dse_yaml_get_double(timing_node, "interval", &st->timing.interval);
+        dse_yaml_get_double(timing_node, "phase", &st->timing.phase);
+        dse_yaml_get_double(timing_node, "lag", &st->timing.lag);
     }
 
     // FIXME: LUA parse the new transform elements.
@@ -251,9 +265,15 @@ void _load_signals(ModelInstanceSpec* model_instance, ChannelSpec* channel_spec,
             log_info("  signal[%u] : %s", i, signal_list->names[i]);
             SignalTransform* st =
                 hashmap_get(&handler_data.transform_map, signal_list->names[i]);
-            if (st)
+            if (st && st->linear.factor != 0.0)
                 log_info("    transform[linear] : factor=%f, offset=%f",
                     st->linear.factor, st->linear.offset);
+            if (st && (st->timing.delay > 0 || st->timing.interval > 0 ||
+                          st->timing.lag > 0))
+                log_info("    transform[timing] : delay=%f, interval=%f, "
+                         "phase=%f, lag=%f",
+                    st->timing.delay, st->timing.interval, st->timing.phase,
+                    st->timing.lag);
         }
     }
     *vector_type = handler_data.signal_vector_type;
@@ -394,6 +414,11 @@ int model_configure_channel(ModelInstanceSpec* model_instance, const char* name,
     mfc->signal_transform = signal_list.transform;
     mfc->signal_annotation = (void**)signal_list.annotation;
 
+    /* Size any timing transforms (delay lines etc.) to the step size. */
+    ModelFunction* mf =
+        controller_get_model_function(model_instance, function_name);
+    controller_transform_init(mfc, mf ? mf->step_size : 0);
+
     /* Brutal, eh? */
     return 0;
 }
@@ -9,7 +9,7 @@
 #include <dse/ncodec/codec.h>
 #include <dse/ncodec/interface/frame.h>
 #include <dse/ncodec/interface/pdu.h>
-#include <dse/modelc/model.h>
+#include <dse/modelc/runtime.h>
 
 
 #define UNUSED(x) ((void)x)
@@ -25,6 +25,14 @@ typedef struct __BinarySignalStream {
 } __BinarySignalStream;
 
 
+/* Indicate that the stream position is not at 0 (i.e. the stream must be
+   repositioned before the next Model Function call). */
+static inline void _mark_dirty(__BinarySignalStream* _s)
+{
+    if (_s->sv->ncodec_dirty) _s->sv->ncodec_dirty[_s->idx] = (_s->pos != 0);
+}
+
+
 static size_t stream_read(
     NCODEC* nc, uint8_t** data, size_t* len, int32_t pos_op)
 {
@@ -52,7 +60,10 @@ static size_t stream_read(
     *data = &s_buffer[_s->pos];
     *len = s_len - _s->pos;
     /* Advance the position indicator. */
-    if (pos_op == NCODEC_POS_UPDATE) _s->pos = s_len;
+    if (pos_op == NCODEC_POS_UPDATE) {
+        _s->pos = s_len;
+        _mark_dirty(_s);
+    }
 
     return *len;
 }
@@ -70,6 +81,7 @@ static size_t stream_write(NCODEC* nc, uint8_t* data, size_t len)
     _s->sv->length[_s->idx] = _s->pos;
     signal_append(_s->sv, _s->idx, data, len);
     _s->pos += len;
+    _mark_dirty(_s);
 
     return len;
 }
@@ -104,6 +116,7 @@ static int64_t stream_seek(NCODEC* nc, size_t pos, int32_t op)
         } else {
             return -EINVAL;
         }
+        _mark_dirty(_s);
         return _s->pos;
     }
     return -ENOSTR;
@@ -143,6 +156,97 @@ static int32_t stream_close(NCODEC* nc)
 }
 
 
+/* Reserve/Commit interface (write in place). */
+
+/**
+model_sv_stream_reserve
+=======================
+
+Reserve space at the current position of the stream of an NCodec (which
+must be connected to a binary signal), so that a codec can encode directly
+into the binary signal. The stream is truncated at the current position.
+
+Parameters
+----------
+nc (void*)
+: NCodec object.
+
+len (size_t)
+: Length of the space to reserve.
+
+data (uint8_t**)
+: (out) Pointer to the reserved space.
+
+Returns
+-------
+0
+: The space was reserved.
+
+-ENOSTR
+: The NCodec does not have a binary signal stream.
+
+-ENOMEM
+: The binary signal could not be resized.
+*/
+int model_sv_stream_reserve(void* nc, size_t len, uint8_t** data)
+{
+    NCodecInstance* _nc = (NCodecInstance*)nc;
+    if (_nc == NULL || _nc->stream == NULL) return -ENOSTR;
+    if (_nc->stream->write != stream_write) return -ENOSTR;
+    if (data == NULL) return -EINVAL;
+
+    __BinarySignalStream* _s = (__BinarySignalStream*)_nc->stream;
+    uint32_t              s_len = _s->sv->length[_s->idx];
+
+    /* Reserve from current pos (i.e. truncate). */
+    if (_s->pos > s_len) _s->pos = s_len;
+    _s->sv->length[_s->idx] = _s->pos;
+    return signal_reserve(_s->sv, _s->idx, len, data);
+}
+
+
+/**
+model_sv_stream_commit
+======================
+
+Commit data written to space reserved with `model_sv_stream_reserve()`, and
+advance the stream position.
+
+Parameters
+----------
+nc (void*)
+: NCodec object.
+
+len (size_t)
+: Length of the data written.
+
+Returns
+-------
+0
+: The data was committed.
+
+-ENOSTR
+: The NCodec does not have a binary signal stream.
+
+-EINVAL
+: The length exceeds the reserved space.
+*/
+int model_sv_stream_commit(void* nc, size_t len)
+{
+    NCodecInstance* _nc = (NCodecInstance*)nc;
+    if (_nc == NULL || _nc->stream == NULL) return -ENOSTR;
+    if (_nc->stream->write != stream_write) return -ENOSTR;
+
+    __BinarySignalStream* _s = (__BinarySignalStream*)_nc->stream;
+    int rc = signal_commit(_s->sv, _s->idx, len);
+    if (rc == 0) {
+        _s->pos += len;
+        _mark_dirty(_s);
+    }
+    return rc;
+}
+
+
 /* Private stream interface. */
 
 void* model_sv_stream_create(SignalVector* sv, uint32_t idx)
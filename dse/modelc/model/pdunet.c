@@ -202,12 +202,57 @@ data (void*)
 void pdunet_visit(
     PduNetworkDesc* net, PduRange* range, PduNetworkVisitFunc visit, void* data)
 {
-    UNUSED(range);
     if (net == NULL || visit == NULL) return;
 
-    for (size_t i = 0; i < vector_len(&net->matrix.pdu); i++) {
-        PduObject* pdu = vector_at(&net->matrix.pdu, i, NULL);
-        if (pdu) visit(net, pdu, data);
+    if (range) {
+        for (size_t i = 0; i < vector_len(&range->pdu_list); i++) {
+            size_t     pdu_idx = *(size_t*)vector_at(&range->pdu_list, i, NULL);
+            PduObject* pdu = vector_at(&net->matrix.pdu, pdu_idx, NULL);
+            if (pdu) visit(net, pdu, data);
+        }
+    } else {
+        for (size_t i = 0; i < vector_len(&net->matrix.pdu); i++) {
+            PduObject* pdu = vector_at(&net->matrix.pdu, i, NULL);
+            if (pdu) visit(net, pdu, data);
+        }
+    }
+}
+
+
+static bool _marshal_changed(PduNetworkDesc* net, Vector* runs)
+{
+    /* Following a Tx the SignalVector and PDU Network values are equal. */
+    double* phys = vector_at(&net->matrix.signal.phys, 0, NULL);
+    for (size_t i = 0; i < vector_len(runs); i++) {
+        PduMarshalRun* run = vector_at(runs, i, NULL);
+        double*        signal = net->msm.scalar + run->signal;
+        double*        source = phys + run->source;
+        for (size_t j = 0; j < run->count; j++) {
+            if (signal[j] != source[j]) return true;
+        }
+    }
+    return false;
+}
+
+
+static void _marshal_range(
+    PduNetworkDesc* net, Vector* runs, PduRange* range, bool in)
+{
+    /* Copy program of the MSM, runs are contained within a range. */
+    double* phys = vector_at(&net->matrix.signal.phys, 0, NULL);
+    for (size_t i = 0; i < vector_len(runs); i++) {
+        PduMarshalRun* run = vector_at(runs, i, NULL);
+        if (range && (run->source < range->offset ||
+                         run->source >= range->offset + range->length)) {
+            continue;
+        }
+        double* signal = net->msm.scalar + run->signal;
+        double* source = phys + run->source;
+        if (in) {
+            memcpy(signal, source, run->count * sizeof(double));
+        } else {
+            memcpy(source, signal, run->count * sizeof(double));
+        }
     }
 }
 
@@ -226,8 +271,10 @@ net (PduNetworkDesc*)
 : PDU Network object.
 
 range (PduRange*)
-: Range object, optional. When NULL the visitor function is called for all PDUs
-  in the PDU Network.
+: Range object, optional. When NULL all PDUs in the PDU Network are processed,
+  otherwise only the PDUs (and signals) of the range are encoded and
+  transmitted. The NCodec stream is truncated, and the schedule evaluated, on
+  the first call for each simulation step.
 
 visit (PduNetworkVisitFunc)
 : Visit callback function, called for each PDU Object in the provided range.
@@ -238,18 +285,28 @@ data (void*)
 void pdunet_tx(PduNetworkDesc* net, PduRange* range, PduNetworkVisitFunc visit,
     void* data, double simulation_time)
 {
-    UNUSED(range);
-    UNUSED(visit);
-    UNUSED(data);
-
     if (net == NULL) return;
     if (simulation_time < 0) simulation_time = 0.0;
+    uint32_t step_time = (simulation_time + net->schedule.step_size_epsilon) /
+                         net->schedule.step_size;
+    bool new_step = (range == NULL) || (net->schedule.tx.valid == false) ||
+                    (step_time != net->schedule.tx.simulation_time);
+    net->schedule.simulation_time = step_time;
+
+    /* Idle step: no PDU is due and no Tx signal has changed. */
+    if (range == NULL && visit == NULL && pdunet_schedule_idle(net) &&
+        pdunet_route_pending(net) == false &&
+        _marshal_changed(net, &net->msm.run_out) == false) {
+        log_debug("PDU Net: TX (idle)");
+        ncodec_truncate(net->ncodec); /* Discard Rx content. */
+        return;
+    }
 
     /* Marshal from SignalVector to PDU Network. */
-    marshal_signalmap_out(net->msm.out);
+    _marshal_range(net, &net->msm.run_out, range, false);
 
     log_debug("PDU Net: TX");
-    ncodec_truncate(net->ncodec);
+    if (new_step) ncodec_truncate(net->ncodec);
 
     /* Configuration (if network requires). */
     if (net->network.vtable.config_done == false) {
@@ -260,14 +317,14 @@ void pdunet_tx(PduNetworkDesc* net, PduRange* range, PduNetworkVisitFunc visit,
     }
 
     /* Schedule, based on normalised simulation time. */
-    net->schedule.simulation_time =
-        (simulation_time + net->schedule.step_size_epsilon) /
-        net->schedule.step_size;
-    pdunet_schedule(net);
-
-    /* Encode PDUs, call visitor, then Tx. */
-    pdunet_encode_linear(net, NULL);
-    pdunet_encode_pack(net, NULL);
+    if (new_step) pdunet_schedule(net);
+
+    /* Route PDUs (from other networks), then encode (patch) PDUs, call
+    visitor, then Tx. */
+    net->range = range;
+    pdunet_route(net);
+    pdunet_encode_linear(net, range);
+    pdunet_encode_pack(net, range);
     pdunet_visit(net, range, pdunet_visit_needs_tx, NULL);
     pdunet_visit(net, range, pdunet_visit_container_mapto, NULL);
     if (visit) pdunet_visit(net, range, visit, data);
@@ -281,10 +338,11 @@ void pdunet_tx(PduNetworkDesc* net, PduRange* range, PduNetworkVisitFunc visit,
     }
 
     ncodec_flush(net->ncodec);
+    net->range = NULL;
+    net->schedule.tx.pending = false;
 
     /* Marshal from PDU Network to SignalVector (update changed signals). */
-    // TODO: trigger on actual Tx to reduce CPU consumption in idle steps.
-    marshal_signalmap_in(net->msm.out);
+    _marshal_range(net, &net->msm.run_out, range, true);
 }
 
 
@@ -301,8 +359,8 @@ net (PduNetworkDesc*)
 : PDU Network object.
 
 range (PduRange*)
-: Range object, optional. When NULL the visitor function is called for all PDUs
-  in the PDU Network.
+: Range object, optional. When NULL all PDUs in the PDU Network are processed,
+  otherwise only the PDUs (and signals) of the range are received and decoded.
 
 visit (PduNetworkVisitFunc)
 : Visit callback function, called for each PDU Object in the provided range.
@@ -313,29 +371,27 @@ data (void*)
 void pdunet_rx(
     PduNetworkDesc* net, PduRange* range, PduNetworkVisitFunc visit, void* data)
 {
-    UNUSED(range);
-    UNUSED(visit);
-    UNUSED(data);
-
     if (net == NULL) return;
 
     log_debug("PDU Net: RX");
     ncodec_seek(net->ncodec, 0, NCODEC_SEEK_SET);
 
     /* Receive PDUs, call visitor. */
+    net->range = range;
     if (net->network.vtable.lpdu_rx) {
         net->network.vtable.lpdu_rx(net);
     }
-    pdunet_visit(net, NULL, pdunet_visit_container_mapfrom, NULL);
+    net->range = NULL;
+    pdunet_visit(net, range, pdunet_visit_container_mapfrom, NULL);
     if (visit) pdunet_visit(net, range, visit, data);
 
     /* Decode PDUs. */
-    pdunet_decode_unpack(net, NULL);
-    pdunet_decode_linear(net, NULL);
-    pdunet_visit(net, NULL, pdunet_visit_clear_update_flag, NULL);
+    pdunet_decode_unpack(net, range);
+    pdunet_decode_linear(net, range);
+    pdunet_visit(net, range, pdunet_visit_clear_update_flag, NULL);
 
     /* Marshal from PDU Network to SignalVector. */
-    marshal_signalmap_in(net->msm.in);
+    _marshal_range(net, &net->msm.run_in, range, true);
 }
 
 
@@ -376,6 +432,7 @@ void pdunet_visit_set_checksum(PduNetworkDesc* net, PduObject* pdu, void* data)
         assert(payload);
         size_t payload_len = pdu->pdu->length;
         pdu->checksum = pdunet_checksum(payload, payload_len);
+        pdu->changed = false;
     }
 }
 
@@ -390,14 +447,29 @@ void pdunet_visit_needs_tx(PduNetworkDesc* net, PduObject* pdu, void* data)
             /* Container PDU, preserve the needs_tx set by schedule. Later
             call to pdunet_visit_container_mapto will call tx function. */
         } else {
-            uint32_t checksum = pdunet_checksum(
-                pdu->ncodec.pdu.payload, pdu->ncodec.pdu.payload_len);
+            bool     changed;
+            uint32_t checksum = pdu->checksum;
+            if (pdu->lua.modifies_payload) {
+                /* Lua functions may modify the payload, use the checksum. */
+                checksum = pdunet_checksum(
+                    pdu->ncodec.pdu.payload, pdu->ncodec.pdu.payload_len);
+                changed = (checksum != pdu->checksum);
+            } else {
+                /* Changed payloads are marked by pack (checksum = 0 forces
+                Tx), the checksum is only calculated on Tx. */
+                changed = pdu->changed || (pdu->checksum == 0);
+                if (changed && pdu->pdu->container.id == 0) {
+                    checksum = pdunet_checksum(
+                        pdu->ncodec.pdu.payload, pdu->ncodec.pdu.payload_len);
+                }
+            }
             log_trace("Pdu: [%u] checksum=%u, new checksum=%u",
                 pdu->matrix.pdu_idx, pdu->checksum, checksum);
-            if (checksum != pdu->checksum) {
+            if (changed) {
                 pdu->needs_tx = true;
                 if (pdu->pdu->container.id == 0) {
                     pdu->checksum = checksum;
+                    pdu->changed = false;
                     /* Apply Tx payload modifications. */
                     pdunet_call_tx_func(net, pdu);
                 } else {
@@ -419,7 +491,13 @@ void pdunet_visit_needs_tx(PduNetworkDesc* net, PduObject* pdu, void* data)
 void pdunet_call_tx_func(PduNetworkDesc* net, PduObject* pdu)
 {
     if (pdu == NULL || pdu->pdu == NULL) return;
-    if ((pdu->needs_tx != true) || (pdu->lua.tx_ref == 0)) return;
+    if (pdu->needs_tx != true) return;
+
+    /* Apply E2E protection (native), the Tx function may further modify
+    the protected payload. */
+    pdunet_e2e_protect(
+        pdu, pdu->ncodec.pdu.payload, pdu->ncodec.pdu.payload_len);
+    if (pdu->lua.tx_ref == 0) return;
 
     /* Evaluate the Lua Tx function which may apply post-checksum payload
     modifications or _reject_ the PDU. */
@@ -457,25 +535,93 @@ int pdunet_call_rx_func(
     PduNetworkDesc* net, PduObject* pdu, uint8_t* payload, size_t payload_len)
 {
     if (pdu == NULL || pdu->pdu == NULL) return 0;
-    if (pdu->lua.rx_ref == 0) return 0;
 
     /* Evaluate the Lua Rx function which may apply payload
     modifications or _reject_ the PDU. */
-    assert(net);
+    if (pdu->lua.rx_ref) {
+        assert(net);
+        assert(net->mi);
+        assert(net->mi->private);
+        ModelInstancePrivate* mip = net->mi->private;
+        lua_State*            L = mip->lua_state;
+
+        log_trace("Lua Call: PDU Rx Rx[%u]: func=%d", pdu->matrix.pdu_idx,
+            pdu->lua.rx_ref);
+
+        int rc = pdunet_lua_pdu_call(
+            L, pdu->lua.rx_ref, payload, payload_len, true);
+        if (rc != 0) {
+            log_trace(
+                "Pdu: [%u] rejected, reason=%d", pdu->matrix.pdu_idx, rc);
+            return rc;
+        }
+    }
+
+    /* Check the E2E protection (native). */
+    int rc = pdunet_e2e_check(pdu, payload, payload_len);
+    if (rc != 0) {
+        log_trace("Pdu: [%u] E2E rejected, reason=%d", pdu->matrix.pdu_idx, rc);
+        return rc;
+    }
+
+    /* Accepted, the payload may be routed. */
+    pdu->route.rx_count++;
+    return 0;
+}
+
+
+/**
+pdunet_call_signal_range_func
+=============================
+
+Call a Lua function once for all signals of a PDU Object. The ctx table passed
+to the function has the arrays `phys` and `raw` (indexed 1..n, in the signal
+order of the PDU Object) and the `payload` of the PDU. Values set in the arrays
+are written back to the PDU Network matrix. Each PDU Object has its own ctx
+table, so a function called for several PDUs may keep state for each of them.
+
+Parameters
+----------
+net (PduNetworkDesc*)
+: PDU Network object.
+
+pdu (PduObject*)
+: PDU Object.
+
+func_ref (lua_func_t)
+: Lua function handle (i.e. a reference in the Lua registry).
+
+Returns
+-------
+0
+: The Lua function was called (or the PDU has no signals).
+
+-EINVAL
+: Bad parameters, or the function handle is not a function.
+
+-1
+: The Lua function failed, or returned an error (ctx.err).
+*/
+int pdunet_call_signal_range_func(
+    PduNetworkDesc* net, PduObject* pdu, lua_func_t func_ref)
+{
+    if (net == NULL || pdu == NULL || pdu->pdu == NULL) return -EINVAL;
+    if (func_ref <= 0) return -EINVAL;
     assert(net->mi);
     assert(net->mi->private);
     ModelInstancePrivate* mip = net->mi->private;
     lua_State*            L = mip->lua_state;
 
-    log_trace("Lua Call: PDU Rx Rx[%u]: func=%d", pdu->matrix.pdu_idx,
-        pdu->lua.rx_ref);
+    size_t offset = pdu->matrix.range.offset;
+    size_t count = pdu->matrix.range.count;
+    if (count == 0) return 0;
+    double*   phys = vector_at(&net->matrix.signal.phys, offset, NULL);
+    uint64_t* raw = vector_at(&net->matrix.signal.raw, offset, NULL);
 
-    int rc =
-        pdunet_lua_pdu_call(L, pdu->lua.rx_ref, payload, payload_len, true);
-    if (rc != 0) {
-        log_trace("Pdu: [%u] rejected, reason=%d", pdu->matrix.pdu_idx, rc);
-    }
-    return rc;
+    log_trace("Lua Call: Signal Range[%u]: offset=%u, count=%u, func=%d",
+        pdu->matrix.pdu_idx, offset, count, func_ref);
+    return pdunet_lua_signal_range_call(L, func_ref, pdu->matrix.pdu_idx, phys,
+        raw, count, pdu->ncodec.pdu.payload, pdu->ncodec.pdu.payload_len);
 }
 
 
@@ -499,9 +645,16 @@ void pdunet_destroy(PduNetworkDesc* net)
         vector_reset(&net->pdus);
         marshal_signalmap_destroy(net->msm.in);
         marshal_signalmap_destroy(net->msm.out);
+        vector_reset(&net->msm.run_in);
+        vector_reset(&net->msm.run_out);
         pdunet_matrix_clear(net);
+        pdunet_schedule_reset(net);
+        vector_reset(&net->route.list);
+        vector_reset(&net->network.vtable.flexray.frame_index);
+        vector_reset(&net->network.vtable.flexray.lpdu_list);
         pdunet_lua_teardown(net);
         if (net->network.metadata.config) free(net->network.metadata.config);
+        free(net->cache.data);
         free(net);
     }
 }
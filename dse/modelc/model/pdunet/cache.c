@@ -0,0 +1,541 @@
+// Copyright 2026 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#define XXH_INLINE_ALL
+#include <dse/clib/data/xxhash.h>
+#include <dse/clib/collections/hashmap.h>
+#include <dse/clib/collections/hashlist.h>
+#include <dse/modelc/model/pdunet/network.h>
+#include <dse/ncodec/interface/pdu.h>
+
+
+/*
+Network Cache
+=============
+
+The parsed PDUs (and Signals) of a Network are serialised to a binary file
+which is loaded, instead of parsing the Network YAML, when the hash of the
+Network YAML (document tree) matches the hash recorded in the file.
+
+Layout (host byte order, all references are offsets):
+
+    CacheHeader
+    CachePdu[pdu_count]
+    CacheSignal[signal_count]
+    uint8_t[pdu_count * metadata_size]  (PDU metadata config)
+    char[strings_size]                  (NUL terminated strings)
+
+The file is position independent and may be used directly from a mapped
+(or loaded) buffer, which is retained as the backing store of the strings
+referenced by the loaded PduItem and PduSignalItem objects.
+*/
+
+#define CACHE_MAGIC   "PDUNETC"
+#define CACHE_VERSION 4
+#define CACHE_NULL    UINT32_MAX
+
+
+typedef struct CacheHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t transport_type;
+    uint64_t hash;
+    /* Record sizes (reject files from a different ABI). */
+    uint32_t pdu_size;
+    uint32_t signal_size;
+    uint32_t metadata_size;
+    /* Section sizes. */
+    uint32_t pdu_count;
+    uint32_t signal_count;
+    uint32_t strings_size;
+} CacheHeader;
+
+typedef struct CachePdu {
+    uint32_t name;
+    uint32_t id;
+    uint64_t length;
+    uint32_t dir;
+    uint32_t container_header;
+    uint32_t container_id;
+    uint32_t container_priority;
+    double   phase;
+    double   interval;
+    uint32_t trigger;
+    uint32_t lua_encode;
+    uint32_t lua_decode;
+    uint32_t lua_tx;
+    uint32_t lua_rx;
+    uint32_t e2e_profile;
+    uint16_t e2e_data_id;
+    uint16_t e2e_crc_offset;
+    uint16_t e2e_counter_offset;
+    uint16_t e2e_counter_bits;
+    uint32_t route_network;
+    uint32_t route_pdu;
+    uint32_t has_metadata;
+    uint32_t signal_count;
+} CachePdu;
+
+typedef struct CacheSignal {
+    uint32_t name;
+    uint16_t start_bit;
+    uint16_t length_bits;
+    uint32_t byte_order;
+    uint32_t is_signed;
+    double   factor;
+    double   offset;
+    double   min;
+    double   max;
+    uint32_t mux_selector;
+    uint32_t mux_muxed;
+    uint32_t mux_value;
+    uint32_t lua_encode;
+    uint32_t lua_decode;
+} CacheSignal;
+
+typedef struct CacheStrings {
+    char*  data;
+    size_t size;
+    size_t capacity;
+} CacheStrings;
+
+
+static size_t _metadata_size(PduNetworkDesc* net)
+{
+    switch (net->network.transport_type) {
+    case NCodecPduTransportTypeCan:
+        return sizeof(NCodecPduCanMessageMetadata);
+    case NCodecPduTransportTypeFlexray:
+        return sizeof(NCodecPduFlexrayLpduConfig);
+    default:
+        return 0;
+    }
+}
+
+
+static uint64_t _hash_str(const char* s, uint64_t seed)
+{
+    /* Include the NUL so that adjacent strings are delimited. */
+    if (s == NULL) return XXH64("", 0, seed ^ 0x9e3779b97f4a7c15ULL);
+    return XXH64(s, strlen(s) + 1, seed);
+}
+
+
+static int _key_compar(const void* left, const void* right)
+{
+    return strcmp(*(const char**)left, *(const char**)right);
+}
+
+
+static uint64_t _hash_node(YamlNode* n, uint64_t seed)
+{
+    if (n == NULL) return seed;
+    uint64_t h = _hash_str(n->name, seed);
+    h = _hash_str(n->scalar, h);
+
+    /* Mapping, hashed in key order (hashmap order is not stable). */
+    uint32_t count = hashmap_number_keys(n->mapping);
+    if (count) {
+        char** keys = hashmap_keys(&n->mapping);
+        qsort(keys, count, sizeof(char*), _key_compar);
+        for (uint32_t i = 0; i < count; i++) {
+            h = _hash_str(keys[i], h);
+            h = _hash_node(hashmap_get(&n->mapping, keys[i]), h);
+            free(keys[i]);
+        }
+        free(keys);
+    }
+
+    /* Sequence. */
+    for (uint32_t i = 0; i < hashlist_length(&n->sequence); i++) {
+        h = _hash_node(hashlist_at(&n->sequence, i), h);
+    }
+    return h;
+}
+
+
+/**
+pdunet_cache_hash
+=================
+
+Calculate a hash of the Network YAML document (the complete document tree)
+which identifies the content of a Network Cache file.
+
+Parameters
+----------
+net (PduNetworkDesc*)
+: PduNetworkDesc object, with a Network YAML document.
+
+Returns
+-------
+uint64_t
+: The hash of the Network YAML document.
+*/
+uint64_t pdunet_cache_hash(PduNetworkDesc* net)
+{
+    assert(net);
+    return _hash_node(net->doc, CACHE_VERSION);
+}
+
+
+static uint32_t _str_add(CacheStrings* s, const char* str)
+{
+    if (str == NULL) return CACHE_NULL;
+    size_t len = strlen(str) + 1;
+    if (s->size + len > s->capacity) {
+        size_t capacity = s->capacity ? s->capacity : 4096;
+        while (s->size + len > capacity)
+            capacity *= 2;
+        char* data = realloc(s->data, capacity);
+        if (data == NULL) return CACHE_NULL;
+        s->data = data;
+        s->capacity = capacity;
+    }
+    uint32_t offset = (uint32_t)s->size;
+    memcpy(s->data + offset, str, len);
+    s->size += len;
+    return offset;
+}
+
+
+static const char* _str_get(const char* strings, uint32_t size, uint32_t o)
+{
+    if (o == CACHE_NULL || o >= size) return NULL;
+    return strings + o;
+}
+
+
+/**
+pdunet_cache_save
+=================
+
+Save the parsed PDUs (and Signals) of a Network to a Network Cache file.
+Call after parsing, and before configure (i.e. no Lua references are set).
+
+Parameters
+----------
+net (PduNetworkDesc*)
+: PduNetworkDesc object.
+
+path (const char*)
+: Path of the Network Cache file.
+
+Returns
+-------
+0
+: The Network Cache file was written.
+
++ve
+: Failure, value is an errno.
+*/
+int pdunet_cache_save(PduNetworkDesc* net, const char* path)
+{
+    assert(net);
+    if (path == NULL) return EINVAL;
+
+    size_t       pdu_count = vector_len(&net->pdus);
+    size_t       signal_count = 0;
+    size_t       md_size = _metadata_size(net);
+    CacheStrings strings = { 0 };
+    char*        tmp_path = NULL;
+    int          rc = 0;
+
+    for (size_t i = 0; i < pdu_count; i++) {
+        PduItem* pdu = vector_at(&net->pdus, i, NULL);
+        signal_count += vector_len(&pdu->signals);
+    }
+    CachePdu*    pdus = calloc(pdu_count + 1, sizeof(CachePdu));
+    CacheSignal* signals = calloc(signal_count + 1, sizeof(CacheSignal));
+    uint8_t*     md = calloc(pdu_count * md_size + 1, 1);
+    if (pdus == NULL || signals == NULL || md == NULL) {
+        rc = ENOMEM;
+        goto cleanup;
+    }
+
+    /* Serialise the PDUs and Signals. */
+    size_t s_idx = 0;
+    for (size_t i = 0; i < pdu_count; i++) {
+        PduItem* pdu = vector_at(&net->pdus, i, NULL);
+        pdus[i] = (CachePdu){
+            .name = _str_add(&strings, pdu->name),
+            .id = pdu->id,
+            .length = pdu->length,
+            .dir = pdu->dir,
+            .container_header = pdu->container.header,
+            .container_id = pdu->container.id,
+            .container_priority = pdu->container.priority,
+            .phase = pdu->schedule.phase,
+            .interval = pdu->schedule.interval,
+            .trigger = pdu->schedule.trigger,
+            .lua_encode = _str_add(&strings, pdu->lua.encode),
+            .lua_decode = _str_add(&strings, pdu->lua.decode),
+            .lua_tx = _str_add(&strings, pdu->lua.tx),
+            .lua_rx = _str_add(&strings, pdu->lua.rx),
+            .e2e_profile = pdu->e2e.profile,
+            .e2e_data_id = pdu->e2e.data_id,
+            .e2e_crc_offset = pdu->e2e.crc_offset,
+            .e2e_counter_offset = pdu->e2e.counter.offset,
+            .e2e_counter_bits = pdu->e2e.counter.bits,
+            .route_network = _str_add(&strings, pdu->route.network),
+            .route_pdu = _str_add(&strings, pdu->route.pdu),
+            .signal_count = vector_len(&pdu->signals),
+        };
+        if (md_size && pdu->metadata.config) {
+            memcpy(md + i * md_size, pdu->metadata.config, md_size);
+            pdus[i].has_metadata = true;
+        }
+        for (size_t j = 0; j < vector_len(&pdu->signals); j++) {
+            PduSignalItem* s = vector_at(&pdu->signals, j, NULL);
+            signals[s_idx++] = (CacheSignal){
+                .name = _str_add(&strings, s->name),
+                .start_bit = s->start_bit,
+                .length_bits = s->length_bits,
+                .byte_order = s->byte_order,
+                .is_signed = s->is_signed,
+                .factor = s->factor,
+                .offset = s->offset,
+                .min = s->min,
+                .max = s->max,
+                .mux_selector = s->mux.selector,
+                .mux_muxed = s->mux.muxed,
+                .mux_value = s->mux.value,
+                .lua_encode = _str_add(&strings, s->lua.encode),
+                .lua_decode = _str_add(&strings, s->lua.decode),
+            };
+        }
+    }
+    if (strings.size > UINT32_MAX - 1) {
+        rc = EFBIG;
+        goto cleanup;
+    }
+
+    /* Write the file. */
+    CacheHeader header = {
+        .magic = CACHE_MAGIC,
+        .version = CACHE_VERSION,
+        .transport_type = net->network.transport_type,
+        .hash = pdunet_cache_hash(net),
+        .pdu_size = sizeof(CachePdu),
+        .signal_size = sizeof(CacheSignal),
+        .metadata_size = md_size,
+        .pdu_count = pdu_count,
+        .signal_count = signal_count,
+        .strings_size = strings.size,
+    };
+    /* Write to a temporary file (in the same directory) and then rename it
+    into place, a concurrent load never sees a partially written file. */
+    size_t tmp_len = strlen(path) + 32;
+    tmp_path = malloc(tmp_len);
+    if (tmp_path == NULL) {
+        rc = ENOMEM;
+        goto cleanup;
+    }
+    snprintf(tmp_path, tmp_len, "%s.%ld.tmp", path, (long)getpid());
+    FILE* f = fopen(tmp_path, "wb");
+    if (f == NULL) {
+        rc = errno;
+        goto cleanup;
+    }
+    if (fwrite(&header, sizeof(header), 1, f) != 1 ||
+        fwrite(pdus, sizeof(CachePdu), pdu_count, f) != pdu_count ||
+        fwrite(signals, sizeof(CacheSignal), signal_count, f) !=
+            signal_count ||
+        fwrite(md, md_size, pdu_count, f) != (md_size ? pdu_count : 0) ||
+        fwrite(strings.data, 1, strings.size, f) != strings.size) {
+        rc = EIO;
+    }
+    if (fclose(f) != 0 && rc == 0) rc = EIO;
+#if defined(_WIN32)
+    /* Windows: rename() does not replace an existing file. */
+    if (rc == 0) remove(path);
+#endif
+    if (rc == 0 && rename(tmp_path, path) != 0) rc = errno ? errno : EIO;
+    if (rc) remove(tmp_path);
+
+cleanup:
+    free(tmp_path);
+    free(pdus);
+    free(signals);
+    free(md);
+    free(strings.data);
+    if (rc) {
+        log_error("Network cache write failed: %s (rc=%d)", path, rc);
+    } else {
+        log_notice("  Network cache written: %s", path);
+    }
+    return rc;
+}
+
+
+static void* _read_file(const char* path, size_t* size)
+{
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) return NULL;
+
+    void* data = NULL;
+    long  len = -1;
+    if (fseek(f, 0, SEEK_END) == 0) len = ftell(f);
+    if (len > 0 && fseek(f, 0, SEEK_SET) == 0) {
+        data = malloc(len);
+        if (data && fread(data, 1, len, f) != (size_t)len) {
+            free(data);
+            data = NULL;
+        }
+    }
+    fclose(f);
+    *size = (data) ? (size_t)len : 0;
+    return data;
+}
+
+
+static int _validate(PduNetworkDesc* net, void* data, size_t size)
+{
+    CacheHeader* h = data;
+    if (size < sizeof(CacheHeader)) return ENOEXEC;
+    if (memcmp(h->magic, CACHE_MAGIC, sizeof(h->magic)) != 0) return ENOEXEC;
+    if (h->version != CACHE_VERSION) return ENOEXEC;
+    if (h->pdu_size != sizeof(CachePdu)) return ENOEXEC;
+    if (h->signal_size != sizeof(CacheSignal)) return ENOEXEC;
+    if (h->metadata_size != _metadata_size(net)) return ENOEXEC;
+    if (h->transport_type != net->network.transport_type) return ENOEXEC;
+    if (h->hash != pdunet_cache_hash(net)) return ENOEXEC;
+
+    size_t expect = sizeof(CacheHeader) +
+                    (size_t)h->pdu_count * sizeof(CachePdu) +
+                    (size_t)h->signal_count * sizeof(CacheSignal) +
+                    (size_t)h->pdu_count * h->metadata_size + h->strings_size;
+    if (size != expect) return ENOEXEC;
+    if (h->strings_size && ((char*)data)[size - 1] != '\0') return ENOEXEC;
+
+    /* Signal counts must agree with the Signal section. */
+    CachePdu* pdus = (CachePdu*)(h + 1);
+    uint64_t  signal_count = 0;
+    for (uint32_t i = 0; i < h->pdu_count; i++) {
+        signal_count += pdus[i].signal_count;
+    }
+    if (signal_count != h->signal_count) return ENOEXEC;
+
+    return 0;
+}
+
+
+/**
+pdunet_cache_load
+=================
+
+Load the PDUs (and Signals) of a Network from a Network Cache file. The
+Network Cache file is only loaded if the hash of the Network YAML matches
+the hash recorded in the file.
+
+Parameters
+----------
+net (PduNetworkDesc*)
+: PduNetworkDesc object, with a Network YAML document and no PDUs.
+
+path (const char*)
+: Path of the Network Cache file.
+
+Returns
+-------
+0
+: The PDUs were loaded from the Network Cache file.
+
++ve
+: Failure, value is an errno. No PDUs are loaded.
+*/
+int pdunet_cache_load(PduNetworkDesc* net, const char* path)
+{
+    assert(net);
+    if (path == NULL) return EINVAL;
+    if (vector_len(&net->pdus)) return EBUSY;
+
+    size_t size = 0;
+    void*  data = _read_file(path, &size);
+    if (data == NULL) return ENOENT;
+    int rc = _validate(net, data, size);
+    if (rc) {
+        log_notice("  Network cache not used: %s (rc=%d)", path, rc);
+        free(data);
+        return rc;
+    }
+
+    /* Locate the sections. */
+    CacheHeader* h = data;
+    CachePdu*    pdus = (CachePdu*)(h + 1);
+    CacheSignal* signals = (CacheSignal*)(pdus + h->pdu_count);
+    uint8_t*     md = (uint8_t*)(signals + h->signal_count);
+    const char*  str = (char*)(md + (size_t)h->pdu_count * h->metadata_size);
+    uint32_t     str_size = h->strings_size;
+
+    /* Construct the PDUs and Signals. */
+    size_t s_idx = 0;
+    for (uint32_t i = 0; i < h->pdu_count; i++) {
+        CachePdu* p = &pdus[i];
+        PduItem   pdu = {
+              .name = _str_get(str, str_size, p->name),
+              .id = p->id,
+              .length = p->length,
+              .dir = p->dir,
+              .container.header = p->container_header,
+              .container.id = p->container_id,
+              .container.priority = p->container_priority,
+              .schedule.phase = p->phase,
+              .schedule.interval = p->interval,
+              .schedule.trigger = p->trigger,
+              .lua.encode = _str_get(str, str_size, p->lua_encode),
+              .lua.decode = _str_get(str, str_size, p->lua_decode),
+              .lua.tx = _str_get(str, str_size, p->lua_tx),
+              .lua.rx = _str_get(str, str_size, p->lua_rx),
+              .e2e.profile = p->e2e_profile,
+              .e2e.data_id = p->e2e_data_id,
+              .e2e.crc_offset = p->e2e_crc_offset,
+              .e2e.counter.offset = p->e2e_counter_offset,
+              .e2e.counter.bits = p->e2e_counter_bits,
+              .route.network = _str_get(str, str_size, p->route_network),
+              .route.pdu = _str_get(str, str_size, p->route_pdu),
+        };
+        if (p->has_metadata) {
+            pdu.metadata.config = calloc(1, h->metadata_size);
+            memcpy(pdu.metadata.config, md + i * h->metadata_size,
+                h->metadata_size);
+        }
+        if (p->signal_count) {
+            pdu.signals = vector_make(
+                sizeof(PduSignalItem), p->signal_count, NULL);
+        }
+        for (uint32_t j = 0; j < p->signal_count; j++) {
+            CacheSignal*  s = &signals[s_idx++];
+            PduSignalItem signal = {
+                .name = _str_get(str, str_size, s->name),
+                .start_bit = s->start_bit,
+                .length_bits = s->length_bits,
+                .byte_order = s->byte_order,
+                .is_signed = s->is_signed,
+                .factor = s->factor,
+                .offset = s->offset,
+                .min = s->min,
+                .max = s->max,
+                .mux.selector = s->mux_selector,
+                .mux.muxed = s->mux_muxed,
+                .mux.value = s->mux_value,
+                .lua.encode = _str_get(str, str_size, s->lua_encode),
+                .lua.decode = _str_get(str, str_size, s->lua_decode),
+            };
+            vector_push(&pdu.signals, &signal);
+        }
+        vector_push(&net->pdus, &pdu);
+    }
+
+    /* Retain the buffer, the strings of the PDUs reference it. */
+    free(net->cache.data);
+    net->cache.data = data;
+    log_notice("  Network cache loaded: %s (%u PDUs, %u Signals)", path,
+        h->pdu_count, h->signal_count);
+    return 0;
+}
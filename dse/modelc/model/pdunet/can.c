@@ -58,7 +58,9 @@ void pdunet_can_lpdu_tx(PduNetworkDesc* net)
     assert(net->ncodec);
     assert(net->network.transport_type == NCodecPduTransportTypeCan);
 
-    for (size_t i = 0; i < vector_len(&net->matrix.pdu); i++) {
+    /* PDUs of the current range (or all PDUs). */
+    for (size_t j = 0; j < pdunet_range_count(net); j++) {
+        size_t     i = pdunet_range_pdu_idx(net, j);
         PduObject* pdu = vector_at(&net->matrix.pdu, i, NULL);
         if (pdu == NULL) continue;
         assert(pdu->pdu);
@@ -95,18 +97,25 @@ void pdunet_can_lpdu_rx(PduNetworkDesc* net)
         if (ncodec_read(net->ncodec, &nc_pdu) < 0) break;
         if (nc_pdu.transport_type != NCodecPduTransportTypeCan) continue;
 
-        for (size_t i = 0; i < vector_len(&net->matrix.pdu); i++) {
+        /* Locate the Rx PDU(s) via the index. */
+        size_t        count = 0;
+        PduIndexItem* index =
+            pdunet_index_find(&net->matrix.rx_index, nc_pdu.id, &count);
+        for (size_t j = 0; j < count; j++) {
+            size_t     i = index[j].idx;
             PduObject* pdu = vector_at(&net->matrix.pdu, i, NULL);
             if (pdu == NULL) continue;
             assert(pdu->pdu);
-            if (pdu->pdu->dir != PduDirectionRx) continue;
-            if (pdu->pdu->container.id != 0) continue; /* Container I-PDU. */
-            if (pdu->pdu->id != nc_pdu.id) continue;
+            if (pdunet_in_range(net, pdu) == false) continue;
 
             size_t len = nc_pdu.payload_len;
             if (len > pdu->ncodec.pdu.payload_len) {
                 len = pdu->ncodec.pdu.payload_len;
             }
+            /* Call the rx function. */
+            int rc =
+                pdunet_call_rx_func(net, pdu, (uint8_t*)nc_pdu.payload, len);
+            if (rc != 0) continue; /* Discarded. */
             uint8_t* payload = NULL;
             vector_at(&(net->matrix.payload), pdu->matrix.pdu_idx, &payload);
             memcpy(payload, nc_pdu.payload, len);
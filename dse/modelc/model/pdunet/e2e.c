@@ -0,0 +1,264 @@
+// Copyright 2026 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dse/modelc/model/pdunet/network.h>
+
+
+/*
+E2E Protection
+==============
+
+Native E2E protection of a PDU payload. The CRC is calculated over the
+payload (excluding the CRC bytes) followed by the Data ID (LSB, MSB), and
+written, BigEndian, at the configured offset. An optional sequence counter
+is written to the payload (before the CRC is calculated) on each Tx, and
+on Rx a repeated counter is rejected.
+*/
+
+
+// CRC8 SAE-J1850 (polynomial 0x1D), nibble table.
+static const uint8_t crc8_table[16] = { 0x00, 0x1D, 0x3A, 0x27, 0x74, 0x69,
+    0x4E, 0x53, 0xE8, 0xF5, 0xD2, 0xCF, 0x9C, 0x81, 0xA6, 0xBB };
+
+// CRC16 CCITT (polynomial 0x1021), nibble table.
+static const uint16_t crc16_table[16] = { 0x0000, 0x1021, 0x2042, 0x3063,
+    0x4084, 0x50A5, 0x60C6, 0x70E7, 0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C,
+    0xD1AD, 0xE1CE, 0xF1EF };
+
+// CRC32 P4 (reflected polynomial 0xC8DF352F), nibble table.
+static const uint32_t crc32p4_table[16] = { 0x00000000, 0x2B2C2BEE,
+    0x565857DC, 0x7D747C32, 0xACB0AFB8, 0x879C8456, 0xFAE8F864, 0xD1C4D38A,
+    0xC8DF352F, 0xE3F31EC1, 0x9E8762F3, 0xB5AB491D, 0x646F9A97, 0x4F43B179,
+    0x3237CD4B, 0x191BE6A5 };
+
+static const struct {
+    uint8_t  width; /* Bytes. */
+    uint32_t init;
+    uint32_t xorout;
+} crc_spec[__PduE2eProfileCount] = {
+    [PduE2eProfileCrc8] = { 1, 0xff, 0xff },
+    [PduE2eProfileCrc16] = { 2, 0xffff, 0x0000 },
+    [PduE2eProfileCrc32] = { 4, 0xffffffff, 0xffffffff },
+};
+
+
+static uint32_t _crc_update(
+    PduE2eProfile profile, uint32_t crc, const uint8_t* p, size_t len)
+{
+    switch (profile) {
+    case PduE2eProfileCrc8:
+        for (size_t i = 0; i < len; i++) {
+            crc ^= p[i];
+            crc = ((crc << 4) & 0xff) ^ crc8_table[(crc >> 4) & 0x0f];
+            crc = ((crc << 4) & 0xff) ^ crc8_table[(crc >> 4) & 0x0f];
+        }
+        break;
+    case PduE2eProfileCrc16:
+        for (size_t i = 0; i < len; i++) {
+            crc ^= (uint32_t)p[i] << 8;
+            crc = ((crc << 4) & 0xffff) ^ crc16_table[(crc >> 12) & 0x0f];
+            crc = ((crc << 4) & 0xffff) ^ crc16_table[(crc >> 12) & 0x0f];
+        }
+        break;
+    case PduE2eProfileCrc32:
+        for (size_t i = 0; i < len; i++) {
+            crc ^= p[i];
+            crc = (crc >> 4) ^ crc32p4_table[crc & 0x0f];
+            crc = (crc >> 4) ^ crc32p4_table[crc & 0x0f];
+        }
+        break;
+    default:
+        break;
+    }
+    return crc;
+}
+
+
+uint32_t pdunet_e2e_crc(PduE2eProfile profile, const uint8_t* p, size_t len)
+{
+    if (profile <= PduE2eProfileNone || profile >= __PduE2eProfileCount) {
+        return 0;
+    }
+    uint32_t crc = _crc_update(profile, crc_spec[profile].init, p, len);
+    return crc ^ crc_spec[profile].xorout;
+}
+
+
+static uint32_t _payload_crc(PduItem* pdu, const uint8_t* payload, size_t len)
+{
+    PduE2eProfile profile = pdu->e2e.profile;
+    size_t        crc_end = pdu->e2e.crc_offset + crc_spec[profile].width;
+    uint8_t data_id[2] = { pdu->e2e.data_id & 0xff, pdu->e2e.data_id >> 8 };
+
+    uint32_t crc = crc_spec[profile].init;
+    crc = _crc_update(profile, crc, payload, pdu->e2e.crc_offset);
+    crc = _crc_update(profile, crc, payload + crc_end, len - crc_end);
+    crc = _crc_update(profile, crc, data_id, sizeof(data_id));
+    return crc ^ crc_spec[profile].xorout;
+}
+
+
+static bool _fits(PduItem* pdu, size_t len)
+{
+    size_t width = crc_spec[pdu->e2e.profile].width;
+    if ((size_t)pdu->e2e.crc_offset + width > len) return false;
+    if (pdu->e2e.counter.bits && pdu->e2e.counter.offset >= len) return false;
+    return true;
+}
+
+
+static uint8_t _counter_mask(PduItem* pdu)
+{
+    return (pdu->e2e.counter.bits == 4) ? 0x0f : 0xff;
+}
+
+
+/**
+pdunet_e2e_validate
+===================
+
+Validate the E2E configuration of a PDU. An invalid configuration is logged
+and the E2E protection of the PDU is disabled.
+
+Parameters
+----------
+pdu (PduItem*)
+: PDU object.
+
+Returns
+-------
+true
+: The E2E configuration is valid (or not configured).
+
+false
+: The E2E configuration is invalid.
+*/
+bool pdunet_e2e_validate(PduItem* pdu)
+{
+    assert(pdu);
+    if (pdu->e2e.profile == PduE2eProfileNone) return true;
+
+    bool   is_valid = true;
+    size_t width = crc_spec[pdu->e2e.profile].width;
+    if (_fits(pdu, pdu->length) == false) {
+        log_error("Invalid E2E: CRC or counter beyond payload length (%s)",
+            pdu->name);
+        is_valid = false;
+    }
+    if (pdu->e2e.counter.bits != 0 && pdu->e2e.counter.bits != 4 &&
+        pdu->e2e.counter.bits != 8) {
+        log_error("Invalid E2E: counter bits must be 4 or 8 (%s)", pdu->name);
+        is_valid = false;
+    }
+    if (pdu->e2e.counter.bits &&
+        pdu->e2e.counter.offset >= pdu->e2e.crc_offset &&
+        pdu->e2e.counter.offset < pdu->e2e.crc_offset + width) {
+        log_error("Invalid E2E: counter overlaps CRC (%s)", pdu->name);
+        is_valid = false;
+    }
+    if (is_valid == false) {
+        pdu->e2e.profile = PduE2eProfileNone;
+    }
+    return is_valid;
+}
+
+
+/**
+pdunet_e2e_protect
+==================
+
+Apply E2E protection (counter and CRC) to a Tx PDU payload.
+
+Parameters
+----------
+pdu (PduObject*)
+: PDU object.
+
+payload (uint8_t*)
+: The PDU payload.
+
+len (size_t)
+: Length of the payload.
+*/
+void pdunet_e2e_protect(PduObject* pdu, uint8_t* payload, size_t len)
+{
+    assert(pdu);
+    PduItem* p = pdu->pdu;
+    if (p->e2e.profile == PduE2eProfileNone || payload == NULL) return;
+    if (_fits(p, len) == false) return;
+
+    if (p->e2e.counter.bits) {
+        uint8_t mask = _counter_mask(p);
+        uint8_t* c = &payload[p->e2e.counter.offset];
+        *c = (*c & ~mask) | (pdu->e2e.counter & mask);
+        pdu->e2e.counter = (pdu->e2e.counter + 1) & mask;
+    }
+
+    uint32_t crc = _payload_crc(p, payload, len);
+    size_t   width = crc_spec[p->e2e.profile].width;
+    for (size_t i = 0; i < width; i++) {
+        payload[p->e2e.crc_offset + i] = crc >> (8 * (width - 1 - i));
+    }
+}
+
+
+/**
+pdunet_e2e_check
+================
+
+Check the E2E protection (CRC and counter) of an Rx PDU payload.
+
+Parameters
+----------
+pdu (PduObject*)
+: PDU object.
+
+payload (uint8_t*)
+: The PDU payload.
+
+len (size_t)
+: Length of the payload.
+
+Returns
+-------
+0
+: The payload passed the E2E check (or is not protected).
+
+EBADMSG
+: The CRC does not match (or the payload is too short).
+
+EALREADY
+: The counter was repeated.
+*/
+int pdunet_e2e_check(PduObject* pdu, const uint8_t* payload, size_t len)
+{
+    assert(pdu);
+    PduItem* p = pdu->pdu;
+    if (p->e2e.profile == PduE2eProfileNone) return 0;
+    if (payload == NULL || _fits(p, len) == false) {
+        pdu->e2e.errors++;
+        return EBADMSG;
+    }
+
+    uint32_t crc = 0;
+    size_t   width = crc_spec[p->e2e.profile].width;
+    for (size_t i = 0; i < width; i++) {
+        crc = (crc << 8) | payload[p->e2e.crc_offset + i];
+    }
+    if (crc != _payload_crc(p, payload, len)) {
+        pdu->e2e.errors++;
+        return EBADMSG;
+    }
+
+    if (p->e2e.counter.bits) {
+        uint8_t counter = payload[p->e2e.counter.offset] & _counter_mask(p);
+        if (pdu->e2e.counter_valid && counter == pdu->e2e.counter) {
+            pdu->e2e.errors++;
+            return EALREADY;
+        }
+        pdu->e2e.counter = counter;
+        pdu->e2e.counter_valid = true;
+    }
+    return 0;
+}
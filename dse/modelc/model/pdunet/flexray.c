@@ -125,7 +125,16 @@ void pdunet_flexray_config(PduNetworkDesc* net)
         },
     });
 
-    /* Allocate and configure LPDU metadata. */
+    /* Allocate and configure LPDU metadata, and the direct tables. */
+    Vector* frame_index = &net->network.vtable.flexray.frame_index;
+    Vector* lpdu_list = &net->network.vtable.flexray.lpdu_list;
+    vector_reset(frame_index);
+    vector_reset(lpdu_list);
+    *frame_index = vector_make(sizeof(size_t), frame_idx, NULL);
+    *lpdu_list = vector_make(sizeof(size_t), frame_idx, NULL);
+    for (size_t i = 0; i < frame_idx; i++) {
+        vector_push(frame_index, &(size_t){ SIZE_MAX });
+    }
     for (size_t i = 0; i < vector_len(&net->matrix.pdu); i++) {
         PduObject* pdu = vector_at(&net->matrix.pdu, i, NULL);
         if (pdu == NULL || pdu->pdu == NULL) continue;
@@ -137,6 +146,10 @@ void pdunet_flexray_config(PduNetworkDesc* net)
         }
         ((NCodecPduFlexrayLpdu*)pdu->ncodec.metadata.lpdu)->frame_config_index =
             pdu_config->index.frame_table;
+        size_t* fi =
+            vector_at(frame_index, pdu_config->index.frame_table, NULL);
+        if (fi) *fi = i;
+        vector_push(lpdu_list, &i);
     }
 
     /* Calculate stateful info. */
@@ -152,11 +165,15 @@ void pdunet_flexray_lpdu_tx(PduNetworkDesc* net)
     assert(net);
     assert(net->ncodec);
     assert(net->network.transport_type == NCodecPduTransportTypeFlexray);
-    for (size_t i = 0; i < vector_len(&net->matrix.pdu); i++) {
+
+    /* L-PDUs only (Container I-PDUs are not in the list). */
+    Vector* lpdu_list = &net->network.vtable.flexray.lpdu_list;
+    for (size_t j = 0; j < vector_len(lpdu_list); j++) {
+        size_t i = *(size_t*)vector_at(lpdu_list, j, NULL);
         PduObject* pdu = vector_at(&net->matrix.pdu, i, NULL);
         if (pdu == NULL) continue;
+        if (pdunet_in_range(net, pdu) == false) continue;
         assert(pdu->pdu);
-        if (pdu->pdu->container.id != 0) continue; /* Container I-PDU. */
         assert(pdu->ncodec.metadata.lpdu);
         NCodecPduFlexrayLpduConfig* pdu_config = pdu->pdu->metadata.config;
         assert(pdu_config);
@@ -200,6 +217,39 @@ void pdunet_flexray_lpdu_tx(PduNetworkDesc* net)
 }
 
 
+static void _lpdu_rx(PduNetworkDesc* net, size_t i, NCodecPdu* nc_pdu)
+{
+    PduObject* pdu = vector_at(&net->matrix.pdu, i, NULL);
+    if (pdu == NULL) return;
+    assert(pdu->pdu);
+    if (pdu->pdu->dir != PduDirectionRx) return;
+    if (pdunet_in_range(net, pdu) == false) return;
+    NCodecPduFlexrayLpduConfig* pdu_config = pdu->pdu->metadata.config;
+    assert(pdu_config);
+
+    size_t len = nc_pdu->payload_len;
+    if (len > pdu->ncodec.pdu.payload_len) {
+        len = pdu->ncodec.pdu.payload_len;
+    }
+    /* Call the rx function. */
+    int rc = pdunet_call_rx_func(net, pdu, (uint8_t*)nc_pdu->payload, len);
+    if (rc != 0) return; /* Discarded. */
+    /* Update the LPDU status (will trigger Tx loop). */
+    NCodecPduFlexrayLpdu* lpdu = pdu->ncodec.metadata.lpdu;
+    if (lpdu) {
+        lpdu->status = nc_pdu->transport.flexray.metadata.lpdu.status;
+        net->schedule.tx.pending = true;
+    }
+    /* Process the payload. */
+    uint8_t* payload = NULL;
+    vector_at(&(net->matrix.payload), pdu->matrix.pdu_idx, &payload);
+    memcpy(payload, nc_pdu->payload, len);
+    pdu->update_signals = true;
+
+    log_debug("  FlexRay: Rx[%u] slot=%u", i, pdu_config->slot_id);
+}
+
+
 void pdunet_flexray_lpdu_rx(PduNetworkDesc* net)
 {
     while (1) {
@@ -241,42 +291,26 @@ void pdunet_flexray_lpdu_rx(PduNetworkDesc* net)
             continue;
         }
 
+        /* Direct lookup, the frame config index identifies the slot and
+        cycle (base/repetition) of the LPDU. */
+        uint32_t frame_config_index =
+            nc_pdu.transport.flexray.metadata.lpdu.frame_config_index;
+        Vector* frame_index = &net->network.vtable.flexray.frame_index;
+        if (vector_len(frame_index)) {
+            size_t* fi = vector_at(frame_index, frame_config_index, NULL);
+            if (fi && *fi != SIZE_MAX) _lpdu_rx(net, *fi, &nc_pdu);
+            continue;
+        }
+        /* Network not configured (no direct table), search for the LPDU. */
         for (size_t i = 0; i < vector_len(&net->matrix.pdu); i++) {
-            // TODO: Speedup: use pdu_config->index.lpdu_table as index to
-            // payload? May need support in NCodec. Similar to
-            // nc_pdu.transport.flexray.metadata.lpdu.frame_config_index and
-            // would give speedup. Want direct lookup.
-
             PduObject* pdu = vector_at(&net->matrix.pdu, i, NULL);
             if (pdu == NULL) continue;
             assert(pdu->pdu);
-            if (pdu->pdu->dir != PduDirectionRx) continue;
             if (pdu->pdu->container.id != 0) continue; /* Container I-PDU. */
             NCodecPduFlexrayLpduConfig* pdu_config = pdu->pdu->metadata.config;
             assert(pdu_config);
-            if (pdu_config->index.frame_table !=
-                nc_pdu.transport.flexray.metadata.lpdu.frame_config_index)
-                continue;
-            size_t len = nc_pdu.payload_len;
-            if (len > pdu->ncodec.pdu.payload_len) {
-                len = pdu->ncodec.pdu.payload_len;
-            }
-            /* Call the rx function. */
-            int rc =
-                pdunet_call_rx_func(net, pdu, (uint8_t*)nc_pdu.payload, len);
-            if (rc != 0) continue; /* Discarded. */
-            /* Update the LPDU status (will trigger Tx loop). */
-            NCodecPduFlexrayLpdu* lpdu = pdu->ncodec.metadata.lpdu;
-            if (lpdu) {
-                lpdu->status = nc_pdu.transport.flexray.metadata.lpdu.status;
-            }
-            /* Process the payload. */
-            uint8_t* payload = NULL;
-            vector_at(&(net->matrix.payload), pdu->matrix.pdu_idx, &payload);
-            memcpy(payload, nc_pdu.payload, len);
-            pdu->update_signals = true;
-
-            log_debug("  FlexRay: Rx[%u] slot=%u", i, pdu_config->slot_id);
+            if (pdu_config->index.frame_table != frame_config_index) continue;
+            _lpdu_rx(net, i, &nc_pdu);
         }
     }
 }
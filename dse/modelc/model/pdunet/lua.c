@@ -108,14 +108,71 @@ static void _push_payload_userdata(lua_State* L, uint8_t* data, uint32_t len)
 }
 
 
-static void _lua_push_pdu_ctx(
-    lua_State* L, uint8_t* payload, uint32_t payload_len)
+/* Context tables (and their payload userdata) are reused, one per Lua
+function and key, and kept in a registry table (cache[func_ref][key + 1]).
+PDU and signal functions have one ctx (key 0), a function called for several
+PDUs has a ctx for each PDU (key is the PDU index). Before each call the
+`payload` (and `phys`/`raw`) fields are set and the `err`/`errmsg` fields are
+cleared; any other fields set by a Lua function persist between calls (and
+may be used by that function to hold state). */
+
+#define CTX_CACHE "pdunet_ctx_cache"
+
+static void _create_ctx_cache(lua_State* L)
+{
+    lua_getfield(L, LUA_REGISTRYINDEX, CTX_CACHE);
+    if (!lua_istable(L, -1)) {
+        lua_newtable(L);
+        lua_setfield(L, LUA_REGISTRYINDEX, CTX_CACHE);
+    }
+    lua_pop(L, 1);
+}
+
+
+static void _lua_push_ctx(lua_State* L, int32_t func_ref, size_t key,
+    uint8_t* payload, uint32_t payload_len)
 {
     // clang-format off
-    lua_newtable(L);                                        // [table]
-    lua_pushstring(L, "payload");                           // [table][payload]
-    _push_payload_userdata(L, payload, payload_len);        // [table][payload][metatable]
-    lua_settable(L, -3);                                    // [table]
+    lua_getfield(L, LUA_REGISTRYINDEX, CTX_CACHE);          // [cache]
+    if (!lua_istable(L, -1)) {
+        lua_pop(L, 1);
+        _create_ctx_cache(L);
+        lua_getfield(L, LUA_REGISTRYINDEX, CTX_CACHE);      // [cache]
+    }
+    lua_rawgeti(L, -1, func_ref);                           // [cache][func]
+    if (!lua_istable(L, -1)) {
+        lua_pop(L, 1);
+        lua_newtable(L);                                    // [cache][func]
+        lua_pushvalue(L, -1);                               // [cache][func][func]
+        lua_rawseti(L, -3, func_ref);                       // [cache][func]
+    }
+    lua_remove(L, -2);                                      // [func]
+    lua_rawgeti(L, -1, (lua_Integer)key + 1);               // [func][table]
+    if (!lua_istable(L, -1)) {
+        lua_pop(L, 1);
+        lua_newtable(L);                                    // [func][table]
+        lua_pushvalue(L, -1);                               // [func][table][table]
+        lua_rawseti(L, -3, (lua_Integer)key + 1);           // [func][table]
+    }
+    lua_remove(L, -2);                                      // [table]
+
+    /* Update the payload userdata (in place). */
+    lua_getfield(L, -1, "payload");                         // [table][payload]
+    payload_wrapper_t* pw = luaL_testudata(L, -1, PAYLOAD_METATABLE);
+    lua_pop(L, 1);                                          // [table]
+    if (pw) {
+        pw->data = payload;
+        pw->len = payload_len;
+    } else {
+        _push_payload_userdata(L, payload, payload_len);    // [table][payload]
+        lua_setfield(L, -2, "payload");                     // [table]
+    }
+
+    /* Clear the error fields (of a previous call). */
+    lua_pushnil(L);                                         // [table][nil]
+    lua_setfield(L, -2, "err");                             // [table]
+    lua_pushnil(L);                                         // [table][nil]
+    lua_setfield(L, -2, "errmsg");                          // [table]
     // clang-format on
 }
 
@@ -137,7 +194,7 @@ int pdunet_lua_pdu_call(lua_State* L, int32_t func_ref, uint8_t* const payload,
         lua_pop(L, 1);
         return -EINVAL;
     }
-    _lua_push_pdu_ctx(L, payload, payload_len);
+    _lua_push_ctx(L, func_ref, 0, payload, payload_len);
     if (lua_pcall(L, 1, 1, 0) != LUA_OK) {
         lua_model_error(L, "lua_pcall() failed");
         lua_pop(L, 1);
@@ -179,20 +236,17 @@ int pdunet_lua_pdu_call(lua_State* L, int32_t func_ref, uint8_t* const payload,
     return 0;
 }
 
-static void _lua_push_signal_ctx(lua_State* L, double phys, uint64_t raw,
-    uint8_t* payload, uint32_t payload_len)
+static void _lua_push_signal_ctx(lua_State* L, int32_t func_ref, double phys,
+    uint64_t raw, uint8_t* payload, uint32_t payload_len)
 {
     // clang-format off
-    lua_newtable(L);                                        // [table]
+    _lua_push_ctx(L, func_ref, 0, payload, payload_len);    // [table]
     lua_pushstring(L, "phys");                              // [table][phys]
     lua_pushnumber(L, phys);                                // [table][phys][double]
     lua_settable(L, -3);                                    // [table]
     lua_pushstring(L, "raw");                               // [table][raw]
     lua_pushinteger(L, (lua_Integer)raw);                   // [table][raw][uint64]
     lua_settable(L, -3);                                    // [table]
-    lua_pushstring(L, "payload");                           // [table][payload]
-    _push_payload_userdata(L, payload, payload_len);        // [table][payload][metatable]
-    lua_settable(L, -3);                                    // [table]
     // clang-format on
 }
 
@@ -209,7 +263,7 @@ int pdunet_lua_signal_call(lua_State* L, int32_t func_ref, double* phys,
         lua_pop(L, 1);
         return -EINVAL;
     }
-    _lua_push_signal_ctx(L, *phys, *raw, payload, payload_len);
+    _lua_push_signal_ctx(L, func_ref, *phys, *raw, payload, payload_len);
     if (lua_pcall(L, 1, 1, 0) != LUA_OK) {
         lua_model_error(L, "lua_pcall() failed");
         lua_pop(L, 1);
@@ -260,6 +314,138 @@ int pdunet_lua_signal_call(lua_State* L, int32_t func_ref, double* phys,
 }
 
 
+/* Set (reusing) an array field of the ctx table, at the top of the stack. */
+static void _lua_set_ctx_array(lua_State* L, const char* name, double* phys,
+    uint64_t* raw, size_t count)
+{
+    lua_getfield(L, -1, name);
+    if (!lua_istable(L, -1) || lua_rawlen(L, -1) != count) {
+        lua_pop(L, 1);
+        lua_createtable(L, count, 0);
+        lua_pushvalue(L, -1);
+        lua_setfield(L, -3, name);
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (phys) lua_pushnumber(L, phys[i]);
+        if (raw) lua_pushinteger(L, (lua_Integer)raw[i]);
+        lua_rawseti(L, -2, i + 1);
+    }
+    lua_pop(L, 1);
+}
+
+static void _lua_get_ctx_array(lua_State* L, int idx, const char* name,
+    double* phys, uint64_t* raw, size_t count)
+{
+    lua_getfield(L, idx, name);
+    if (lua_istable(L, -1)) {
+        for (size_t i = 0; i < count; i++) {
+            lua_rawgeti(L, -1, i + 1);
+            if (phys && lua_isnumber(L, -1)) phys[i] = lua_tonumber(L, -1);
+            if (raw && lua_isinteger(L, -1)) {
+                raw[i] = (uint64_t)lua_tointeger(L, -1);
+            }
+            lua_pop(L, 1);
+        }
+    }
+    lua_pop(L, 1);
+}
+
+/**
+pdunet_lua_signal_range_call
+============================
+
+Call a Lua function once for a range of signals. The ctx table passed to the
+function has the arrays `phys` and `raw` (indexed 1..count) and the
+`payload`, and is reused (as are the arrays) by subsequent calls with the
+same function and key.
+
+Parameters
+----------
+L (lua_State*)
+: Lua state.
+
+func_ref (int32_t)
+: Reference of the Lua function.
+
+key (size_t)
+: Key of the ctx table, each key has its own ctx (e.g. the PDU index).
+
+phys (double*)
+: Array of physical signal values, updated from the ctx table.
+
+raw (uint64_t*)
+: Array of raw signal values, updated from the ctx table.
+
+count (size_t)
+: Number of signals in the range.
+
+payload (uint8_t*)
+: The PDU payload, optional.
+
+payload_len (uint32_t)
+: Length of the payload.
+
+Returns
+-------
+0
+: The Lua function was called.
+
+-EINVAL
+: Bad parameters, or the function reference is not a function.
+
+-1
+: The Lua function failed, or returned an error (ctx.err).
+*/
+int pdunet_lua_signal_range_call(lua_State* L, int32_t func_ref, size_t key,
+    double* phys, uint64_t* raw, size_t count, uint8_t* payload,
+    uint32_t payload_len)
+{
+    if (L == NULL) return -EINVAL;
+    if (phys == NULL) return -EINVAL;
+    if (raw == NULL) return -EINVAL;
+    if (payload == NULL) payload_len = 0;
+
+    lua_rawgeti(L, LUA_REGISTRYINDEX, func_ref);
+    if (!lua_isfunction(L, -1)) {
+        lua_pop(L, 1);
+        return -EINVAL;
+    }
+    _lua_push_ctx(L, func_ref, key, payload, payload_len);
+    _lua_set_ctx_array(L, "phys", phys, NULL, count);
+    _lua_set_ctx_array(L, "raw", NULL, raw, count);
+    if (lua_pcall(L, 1, 1, 0) != LUA_OK) {
+        lua_model_error(L, "lua_pcall() failed");
+        lua_pop(L, 1);
+        return -1;
+    }
+    if (!lua_istable(L, -1)) {
+        lua_pop(L, 1);
+        return 0;
+    }
+    int idx = lua_gettop(L);
+
+    // Check the ctx table for an err.
+    lua_getfield(L, idx, "err");
+    int err = lua_isinteger(L, -1) ? (int)lua_tointeger(L, -1) : 0;
+    lua_pop(L, 1);
+    if (err) {
+        lua_getfield(L, idx, "errmsg");
+        const char* msg = lua_isstring(L, -1) ? lua_tostring(L, -1) : NULL;
+        if (msg && __log_level__ != LOG_QUIET) {
+            log_error("lua call returned error: %s (%d)", msg, err);
+        }
+        lua_pop(L, 2);
+        return -1;
+    }
+
+    // Update the values.
+    _lua_get_ctx_array(L, idx, "raw", NULL, raw, count);
+    _lua_get_ctx_array(L, idx, "phys", phys, NULL, count);
+    lua_pop(L, 1);
+    return 0;
+}
+
+
 void pdunet_load_lua_func(YamlNode* n, const char* path, const char** out)
 {
     *out = NULL;
@@ -296,6 +482,7 @@ int pdunet_lua_setup(PduNetworkDesc* net)
     /* Setup Lua interpreter for PDU Net. */
     lua_State* L = mip->lua_state;
     _create_payload_metatable(L);
+    _create_ctx_cache(L);
 
     return 0;
 }
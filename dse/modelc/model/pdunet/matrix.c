@@ -48,9 +48,8 @@ void pdunet_decode_linear(PduNetworkDesc* net, PduRange* range)
 
 void pdunet_encode_pack(PduNetworkDesc* net, PduRange* range)
 {
-    // NOTE: pack only PDUs that need updating. When this
-    // occurs the basis for checksum calculation may be moved to
-    // after calls to pdunet_call_tx_func(), if desirable.
+    // NOTE: pack marks PDUs with changed payloads (PduObject.changed), PDUs
+    // modified by Lua functions are detected by checksum.
     _apply_range(net, range, PduDirectionTx, pdunet_pdu_pack_range);
 }
 
@@ -89,17 +88,26 @@ static const matrix_item_spec matrix_vector_offset_list[] = {
     { offsetof(PduTransformMatrix, signal.signal_idx), sizeof(size_t), NULL },
     { offsetof(PduTransformMatrix, signal.name), sizeof(const char*), NULL },
     { offsetof(PduTransformMatrix, signal.skip), sizeof(bool), NULL },
+    { offsetof(PduTransformMatrix, signal.inactive), sizeof(uint8_t), NULL },
     { offsetof(PduTransformMatrix, signal.phys), sizeof(double), NULL },
     { offsetof(PduTransformMatrix, signal.raw), sizeof(uint64_t), NULL },
     { offsetof(PduTransformMatrix, signal.factor), sizeof(double), NULL },
     { offsetof(PduTransformMatrix, signal.offset), sizeof(double), NULL },
     { offsetof(PduTransformMatrix, signal.min), sizeof(double), NULL },
     { offsetof(PduTransformMatrix, signal.max), sizeof(double), NULL },
+    { offsetof(PduTransformMatrix, signal.linear), sizeof(uint8_t), NULL },
     { offsetof(PduTransformMatrix, signal.encode), sizeof(lua_func_t), NULL },
     { offsetof(PduTransformMatrix, signal.decode), sizeof(lua_func_t), NULL },
     { offsetof(PduTransformMatrix, signal.start_bit), sizeof(uint16_t), NULL },
     { offsetof(PduTransformMatrix, signal.length_bits), sizeof(uint16_t),
         NULL },
+    { offsetof(PduTransformMatrix, signal.is_signed), sizeof(bool), NULL },
+    { offsetof(PduTransformMatrix, signal.byte_order), sizeof(uint8_t), NULL },
+    { offsetof(PduTransformMatrix, signal.byte_offset), sizeof(uint16_t),
+        NULL },
+    { offsetof(PduTransformMatrix, signal.byte_count), sizeof(uint8_t), NULL },
+    { offsetof(PduTransformMatrix, signal.shift), sizeof(uint8_t), NULL },
+    { offsetof(PduTransformMatrix, signal.mask), sizeof(uint64_t), NULL },
 };
 #define MATRIX_SIGNAL_OFFSET 3
 #define MATRIX_RANGE_OFFSET  2
@@ -138,12 +146,17 @@ void pdunet_matrix_clear(PduNetworkDesc* net)
     for (size_t i = 0; i < vector_len(&net->matrix.range); i++) {
         PduRange* range = vector_at(&net->matrix.range, i, NULL);
         vector_reset(&range->pdu_list);
+        vector_reset(&range->scalar_list);
+        vector_reset(&range->mux_list);
     }
     for (size_t i = 0; i < vector_len(&net->matrix.pdu); i++) {
         PduObject* pdu = vector_at(&net->matrix.pdu, i, NULL);
         if (pdu->ncodec.metadata.lpdu) free(pdu->ncodec.metadata.lpdu);
         vector_reset(&pdu->container.pdu_list);
+        vector_reset(&pdu->container.id_index);
+        vector_reset(&pdu->mux.group);
     }
+    vector_reset(&net->matrix.rx_index);
     for (size_t i = 0; i < ARRAY_SIZE(matrix_vector_offset_list); i++) {
         const matrix_item_spec* m = &matrix_vector_offset_list[i];
         Vector*                 v = matrix_vec_at(&net->matrix, m->offset);
@@ -177,6 +190,46 @@ static void _initialise_pdu(PduNetworkDesc* net, PduObject* o)
     };
 }
 
+typedef struct SignalOrder {
+    bool     muxed;
+    uint32_t value;
+    size_t   idx;
+} SignalOrder;
+
+static int _sort_signal_order(const void* left, const void* right)
+{
+    const SignalOrder* l = left;
+    const SignalOrder* r = right;
+    if (l->muxed != r->muxed) return l->muxed ? 1 : -1;
+    if (l->value != r->value) return (l->value < r->value) ? -1 : 1;
+    if (l->idx != r->idx) return (l->idx < r->idx) ? -1 : 1;
+    return 0;
+}
+
+static SignalOrder* _signal_order(PduItem* p)
+{
+    size_t       count = vector_len(&p->signals);
+    SignalOrder* order = calloc(count + 1, sizeof(SignalOrder));
+    size_t       selectors = 0;
+    bool         muxed = false;
+    for (size_t i = 0; i < count; i++) {
+        PduSignalItem* s = vector_at(&p->signals, i, NULL);
+        if (s->mux.selector) selectors++;
+        if (s->mux.muxed) muxed = true;
+        order[i] = (SignalOrder){
+            .muxed = s->mux.muxed, .value = s->mux.value, .idx = i
+        };
+    }
+    if (muxed && selectors != 1) {
+        log_error("Multiplexed PDU requires one selector signal (%s)", p->name);
+        for (size_t i = 0; i < count; i++) {
+            order[i].muxed = false;
+        }
+    }
+    qsort(order, count, sizeof(SignalOrder), _sort_signal_order);
+    return order;
+}
+
 int pdunet_matrix_transform(PduNetworkDesc* net, PduNetworkSortFunc sort)
 {
     UNUSED(sort);
@@ -210,6 +263,8 @@ int pdunet_matrix_transform(PduNetworkDesc* net, PduNetworkSortFunc sort)
                 .decode_ref = p->lua.decode_ref,
                 .tx_ref = p->lua.tx_ref,
                 .rx_ref = p->lua.rx_ref,
+                .modifies_payload = (p->lua.encode_ref > 0) ||
+                                    (p->lua.tx_ref > 0),
             }
         };
         vector_push(&(net->matrix.pdu), &o);
@@ -256,14 +311,39 @@ int pdunet_matrix_transform(PduNetworkDesc* net, PduNetworkSortFunc sort)
         }
         o->schedule.trigger = p->schedule.trigger;
 
-        // Signal -> matrix.signal.
-        for (size_t sig_idx = 0; sig_idx < vector_len(&o->pdu->signals);
-            sig_idx++) {
+        // Signal -> matrix.signal. Multiplexed signals are ordered (by
+        // selector value) after the other signals of the PDU, forming a
+        // sub-range for each selector value.
+        SignalOrder* order = _signal_order(o->pdu);
+        o->mux.active = SIZE_MAX;
+        for (size_t k = 0; k < vector_len(&o->pdu->signals); k++) {
+            size_t         sig_idx = order[k].idx;
+            size_t         matrix_idx = signal_offset + k;
             PduSignalItem* s = vector_at(&o->pdu->signals, sig_idx, NULL);
             log_trace("Matrix:[%u]  Signal[%u]%s: encode_ref=%d, decode_ref=%d",
-                signal_offset + sig_idx, sig_idx, s->name, s->lua.encode_ref,
+                matrix_idx, sig_idx, s->name, s->lua.encode_ref,
                 s->lua.decode_ref);
 
+            // Multiplexing (all multiplexed signals initially inactive).
+            if (s->mux.selector) o->mux.selector = matrix_idx;
+            vector_push(
+                &net->matrix.signal.inactive, &(uint8_t){ order[k].muxed });
+            if (order[k].muxed) {
+                size_t n = vector_len(&o->mux.group);
+                if (n == 0) {
+                    o->mux.group = vector_make(sizeof(PduMuxGroup), 4, NULL);
+                }
+                PduMuxGroup* g =
+                    (n) ? vector_at(&o->mux.group, n - 1, NULL) : NULL;
+                if (g == NULL || g->value != order[k].value) {
+                    vector_push(&o->mux.group,
+                        &(PduMuxGroup){ .value = order[k].value,
+                            .offset = matrix_idx });
+                    g = vector_at(&o->mux.group, n, NULL);
+                }
+                g->count++;
+            }
+
             // Index to matrix pdu, not net pdu.
             vector_push(&net->matrix.signal.pdu_idx, &pdu_idx);
             vector_push(&net->matrix.signal.signal_idx, &sig_idx);
@@ -276,11 +356,29 @@ int pdunet_matrix_transform(PduNetworkDesc* net, PduNetworkSortFunc sort)
             vector_push(&net->matrix.signal.offset, &s->offset);
             vector_push(&net->matrix.signal.min, &s->min);
             vector_push(&net->matrix.signal.max, &s->max);
+            vector_push(&net->matrix.signal.linear,
+                &(uint8_t){ s->lua.encode_ref <= 0 &&
+                            s->lua.decode_ref <= 0 && !isnan(s->factor) &&
+                            !isnan(s->offset) &&
+                            (s->is_signed || s->length_bits < 64) });
             vector_push(&net->matrix.signal.encode, &s->lua.encode_ref);
+            if (s->lua.encode_ref > 0) o->lua.modifies_payload = true;
             vector_push(&net->matrix.signal.decode, &s->lua.decode_ref);
             vector_push(&net->matrix.signal.start_bit, &s->start_bit);
             vector_push(&net->matrix.signal.length_bits, &s->length_bits);
+            vector_push(&net->matrix.signal.is_signed, &s->is_signed);
+
+            // Pack/Unpack layout (signal was validated when parsed).
+            PduSignalLayout layout = {};
+            pdunet_signal_layout(s, o->pdu->length, &layout);
+            vector_push(
+                &net->matrix.signal.byte_order, &(uint8_t){ s->byte_order });
+            vector_push(&net->matrix.signal.byte_offset, &layout.byte_offset);
+            vector_push(&net->matrix.signal.byte_count, &layout.byte_count);
+            vector_push(&net->matrix.signal.shift, &layout.shift);
+            vector_push(&net->matrix.signal.mask, &layout.mask);
         }
+        free(order);
         signal_offset += vector_len(&o->pdu->signals);
     }
 
@@ -290,6 +388,17 @@ int pdunet_matrix_transform(PduNetworkDesc* net, PduNetworkSortFunc sort)
         _initialise_pdu(net, o);
     }
 
+    // Rx index (by id), used to locate received PDUs.
+    net->matrix.rx_index = pdunet_index_make(vector_len(&net->matrix.pdu));
+    for (size_t i = 0; i < vector_len(&net->matrix.pdu); i++) {
+        PduObject* o = vector_at(&(net->matrix.pdu), i, NULL);
+        if (o->pdu->dir != PduDirectionRx) continue;
+        if (o->pdu->container.id != 0) continue; /* Container I-PDU. */
+        vector_push(&net->matrix.rx_index,
+            &(PduIndexItem){ .id = o->pdu->id, .idx = i });
+    }
+    vector_sort(&net->matrix.rx_index);
+
     // Range objects.
     size_t       sig_count = 0;
     size_t       sig_offset = 0;
@@ -333,10 +442,130 @@ int pdunet_matrix_transform(PduNetworkDesc* net, PduNetworkSortFunc sort)
     }
     vector_reset(&pdu_list);
 
+    // Link PDU Objects to their range (range vector is now complete), and
+    // partition the signals of each range (linear / scalar).
+    for (size_t i = 0; i < vector_len(&net->matrix.range); i++) {
+        PduRange* r = vector_at(&net->matrix.range, i, NULL);
+        for (size_t j = 0; j < vector_len(&r->pdu_list); j++) {
+            size_t pdu_idx = *(size_t*)vector_at(&r->pdu_list, j, NULL);
+            PduObject* o = vector_at(&(net->matrix.pdu), pdu_idx, NULL);
+            o->matrix.pdu_range = r;
+            if (vector_len(&o->mux.group)) {
+                if (vector_len(&r->mux_list) == 0) {
+                    r->mux_list = vector_make(sizeof(size_t), 4, NULL);
+                }
+                vector_push(&r->mux_list, &pdu_idx);
+            }
+        }
+        uint8_t* linear =
+            vector_at(&net->matrix.signal.linear, r->offset, NULL);
+        r->scalar_list = vector_make(sizeof(size_t), 0, NULL);
+        for (size_t j = 0; j < r->length; j++) {
+            if (linear[j] == 0) vector_push(&r->scalar_list, &j);
+        }
+    }
+
     return 0;
 }
 
 
+static inline uint64_t _to_raw(
+    double phys, double factor, double offset, bool is_signed)
+{
+    double v = (phys - offset) / factor;
+    if (is_signed) return (uint64_t)(int64_t)v; /* Two's complement. */
+    return (uint64_t)v;
+}
+
+static inline double _to_phys(
+    uint64_t raw, double factor, double offset, bool is_signed)
+{
+    if (is_signed) return ((int64_t)raw * factor) + offset;
+    return (raw * factor) + offset;
+}
+
+/* Linear partition (no Lua, valid factor/offset, raw fits int64_t). These
+loops are branch free so that the compiler may vectorise them: masks are
+byte vectors, and isgreater()/isless() are quiet compares (NaN min/max, i.e.
+no constraint, compare false). Results of signals which are not calculated
+are discarded. */
+static void _linear_encode(size_t n, const uint8_t* restrict linear,
+    const uint8_t* restrict skip, const double* restrict phys,
+    const double* restrict factor, const double* restrict offset,
+    const double* restrict min, const double* restrict max,
+    int64_t* restrict raw)
+{
+    for (size_t i = 0; i < n; i++) {
+        double  p = phys[i];
+        int64_t r = (int64_t)((p - offset[i]) / factor[i]);
+        int64_t ok = (int64_t)(linear[i] & !skip[i]) & !isgreater(p, max[i]) &
+                     !isless(p, min[i]);
+        raw[i] = ok ? r : raw[i];
+    }
+}
+
+static void _linear_decode(size_t n, const uint8_t* restrict linear,
+    const int64_t* restrict raw, const double* restrict factor,
+    const double* restrict offset, const double* restrict min,
+    const double* restrict max, double* restrict phys)
+{
+    for (size_t i = 0; i < n; i++) {
+        double  v = (double)raw[i] * factor[i] + offset[i];
+        int64_t ok = (int64_t)linear[i] & !isgreater(v, max[i]) &
+                     !isless(v, min[i]);
+        phys[i] = ok ? v : phys[i];
+    }
+}
+
+
+/* Active signals of a range, visited as spans (range relative). A span is
+either a run of non-multiplexed signals or the active group of a multiplexed
+PDU, the signals of inactive groups are not visited.
+
+    for (RangeSpan s = {}; _range_span(net, r, &s);) {
+        for (size_t i = s.begin; i < s.end; i++) ...
+    }
+*/
+typedef struct RangeSpan {
+    size_t begin;
+    size_t end;
+    /* Iterator state. */
+    size_t pos; /* Next signal. */
+    size_t mux; /* Next multiplexed PDU (index into r->mux_list). */
+    struct {
+        size_t begin;
+        size_t end;
+    } group; /* Active group, visited after the preceding span. */
+} RangeSpan;
+
+static bool _range_span(PduNetworkDesc* net, PduRange* r, RangeSpan* s)
+{
+    if (s->group.end > s->group.begin) {
+        s->begin = s->group.begin;
+        s->end = s->group.end;
+        s->group.begin = s->group.end = 0;
+        return true;
+    }
+    if (s->pos >= r->length) return false;
+
+    s->begin = s->pos;
+    s->end = s->pos = r->length;
+    if (s->mux < vector_len(&r->mux_list)) {
+        /* Signals up to the multiplexed signals of the next PDU. */
+        size_t pdu_idx = *(size_t*)vector_at(&r->mux_list, s->mux++, NULL);
+        PduObject*   o = vector_at(&net->matrix.pdu, pdu_idx, NULL);
+        PduMuxGroup* g = vector_at(&o->mux.group, 0, NULL);
+        s->end = g->offset - r->offset;
+        s->pos = o->matrix.range.offset + o->matrix.range.count - r->offset;
+        if (o->mux.active != SIZE_MAX) {
+            g += o->mux.active;
+            s->group.begin = g->offset - r->offset;
+            s->group.end = s->group.begin + g->count;
+        }
+    }
+    return true;
+}
+
 void pdunet_pdu_calculate_linear_range(PduNetworkDesc* net, PduRange* r)
 {
     assert(net);
@@ -354,24 +583,33 @@ void pdunet_pdu_calculate_linear_range(PduNetworkDesc* net, PduRange* r)
     double* min = (double*)vector_at(&net->matrix.signal.min, r->offset, NULL);
     double* max = (double*)vector_at(&net->matrix.signal.max, r->offset, NULL);
     uint64_t* raw = (uint64_t*)vector_at(&net->matrix.signal.raw, r->offset, NULL);
+    uint8_t* linear = (uint8_t*)vector_at(&net->matrix.signal.linear, r->offset, NULL);
+    uint8_t* inactive = (uint8_t*)vector_at(&net->matrix.signal.inactive, r->offset, NULL);
     lua_func_t* encode = (lua_func_t*)vector_at(&net->matrix.signal.encode, r->offset, NULL);
     lua_func_t* decode = (lua_func_t*)vector_at(&net->matrix.signal.decode, r->offset, NULL);
     size_t* pdu_idx = (size_t*)vector_at(&net->matrix.signal.pdu_idx, r->offset, NULL);
+    bool* is_signed = (bool*)vector_at(&net->matrix.signal.is_signed, r->offset, NULL);
     // clang-format on
 
-    /* Linear function. */
+    /* Linear function, vectorised for the linear partition of the range and
+    then individually for the remaining (scalar) signals. */
     switch (r->dir) {
     case PduDirectionTx:
-        for (size_t i = 0; i < r->length; i++) {
+        /* All signals are encoded, a multiplexer selection is made when the
+        range is packed (from the encoded selector) and the signals of a
+        newly selected group are packed in the same step. */
+        _linear_encode(r->length, linear, (uint8_t*)skip, phys, factor, offset,
+            min, max, (int64_t*)raw);
+        for (size_t _ = 0; _ < vector_len(&r->scalar_list); _++) {
+            size_t i = *(size_t*)vector_at(&r->scalar_list, _, NULL);
             /* Schedule visitor will set skip is PDU/Signal should not update.*/
             if (LIKELY(skip[i])) continue;
             /* Constraints on the calculation. */
-            // TODO: can these constrains be removed from the matrix?
             if (!isnan(max[i]) && phys[i] > max[i]) continue;
             if (!isnan(min[i]) && phys[i] < min[i]) continue;
             if (isnan(factor[i]) || isnan(offset[i])) continue;
             /* Calculate the raw value. */
-            raw[i] = (phys[i] - offset[i]) / factor[i];
+            raw[i] = _to_raw(phys[i], factor[i], offset[i], is_signed[i]);
             /* Call the Lua function. */
             if (encode[i] > 0) {
                 double   _phys = phys[i];
@@ -394,14 +632,18 @@ void pdunet_pdu_calculate_linear_range(PduNetworkDesc* net, PduRange* r)
                     if (!isnan(min[i]) && phys[i] < min[i]) break;
                     if (isnan(factor[i]) || isnan(offset[i])) break;
                     /* Update the raw value. */
-                    raw[i] = (phys[i] - offset[i]) / factor[i];
+                    raw[i] =
+                        _to_raw(phys[i], factor[i], offset[i], is_signed[i]);
                     log_trace("  phys=%f, raw=%u (updated)", phys[i], raw[i]);
                 }
             }
         }
         break;
     case PduDirectionRx:
-        for (size_t i = 0; i < r->length; i++) {
+        for (size_t _ = 0; _ < vector_len(&r->scalar_list); _++) {
+            size_t i = *(size_t*)vector_at(&r->scalar_list, _, NULL);
+            /* Multiplexed signals, only decode the selected group. */
+            if (inactive[i]) continue;
             /* Call the Lua function. */
             if (decode[i] > 0) {
                 double   _phys = phys[i];
@@ -421,7 +663,8 @@ void pdunet_pdu_calculate_linear_range(PduNetworkDesc* net, PduRange* r)
                     raw[i] = _raw;
                     /* Raw value changed, update phys. */
                     if (isnan(factor[i]) || isnan(offset[i])) break;
-                    double val = (raw[i] * factor[i]) + offset[i];
+                    double val =
+                        _to_phys(raw[i], factor[i], offset[i], is_signed[i]);
                     if (!isnan(max[i]) && val > max[i]) break;
                     if (!isnan(min[i]) && val < min[i]) break;
                     /* Update the phys value. */
@@ -432,11 +675,16 @@ void pdunet_pdu_calculate_linear_range(PduNetworkDesc* net, PduRange* r)
 
             /* Calculate the raw value. */
             if (isnan(factor[i]) || isnan(offset[i])) continue;
-            double val = (raw[i] * factor[i]) + offset[i];
+            double val = _to_phys(raw[i], factor[i], offset[i], is_signed[i]);
             if (!isnan(max[i]) && val > max[i]) continue;
             if (!isnan(min[i]) && val < min[i]) continue;
             phys[i] = val;
         }
+        for (RangeSpan s = {}; _range_span(net, r, &s);) {
+            size_t b = s.begin;
+            _linear_decode(s.end - b, linear + b, (int64_t*)raw + b,
+                factor + b, offset + b, min + b, max + b, phys + b);
+        }
         break;
     default:
         break;
@@ -444,6 +692,158 @@ void pdunet_pdu_calculate_linear_range(PduNetworkDesc* net, PduRange* r)
 }
 
 
+int pdunet_signal_layout(
+    PduSignalItem* s, size_t pdu_length, PduSignalLayout* layout)
+{
+    assert(s);
+    assert(layout);
+    size_t length = s->length_bits;
+    if (length == 0 || length > 64) return EINVAL;
+
+    size_t first_byte = s->start_bit / 8;
+    size_t last_byte;
+    size_t shift;
+    switch (s->byte_order) {
+    case PduByteOrderBigEndian: {
+        /* Start bit is the MSB, position in a (big endian) bit stream. */
+        size_t msb_pos = first_byte * 8 + (7 - s->start_bit % 8);
+        size_t lsb_pos = msb_pos + length - 1;
+        last_byte = lsb_pos / 8;
+        shift = 7 - (lsb_pos % 8);
+        if ((last_byte - first_byte + 1) > 8) return EINVAL;
+        break;
+    }
+    default:
+        /* Start bit is the LSB, word may extend into a 9th byte. */
+        shift = s->start_bit % 8;
+        last_byte = first_byte + (shift + length - 1) / 8;
+        break;
+    }
+    if (last_byte >= pdu_length) return EINVAL;
+
+    layout->byte_offset = first_byte;
+    layout->byte_count = last_byte - first_byte + 1;
+    layout->shift = shift;
+    layout->mask = (length == 64) ? UINT64_MAX : ((1ULL << length) - 1);
+    return 0;
+}
+
+
+static inline uint64_t _load_le(const uint8_t* p, size_t n)
+{
+    uint64_t w = 0;
+    for (size_t k = 0; k < n; k++)
+        w |= (uint64_t)p[k] << (8 * k);
+    return w;
+}
+
+static inline void _store_le(uint8_t* p, size_t n, uint64_t w)
+{
+    for (size_t k = 0; k < n; k++)
+        p[k] = (uint8_t)(w >> (8 * k));
+}
+
+static inline uint64_t _load_be(const uint8_t* p, size_t n)
+{
+    uint64_t w = 0;
+    for (size_t k = 0; k < n; k++)
+        w = (w << 8) | p[k];
+    return w;
+}
+
+static inline void _store_be(uint8_t* p, size_t n, uint64_t w)
+{
+    for (size_t k = n; k > 0; k--) {
+        p[k - 1] = (uint8_t)w;
+        w >>= 8;
+    }
+}
+
+/* Returns true if the payload was changed. */
+static inline bool _pack_word(uint8_t* p, uint8_t order, size_t count,
+    size_t shift, uint64_t mask, uint64_t value)
+{
+    value &= mask;
+    if (order == PduByteOrderBigEndian) {
+        uint64_t w = _load_be(p, count);
+        uint64_t n = (w & ~(mask << shift)) | (value << shift);
+        if (n == w) return false;
+        _store_be(p, count, n);
+    } else if (LIKELY(count <= 8)) {
+        uint64_t w = _load_le(p, count);
+        uint64_t n = (w & ~(mask << shift)) | (value << shift);
+        if (n == w) return false;
+        _store_le(p, count, n);
+    } else {
+        /* Word extends into a 9th byte (shift > 0). */
+        uint64_t w = _load_le(p, 8);
+        uint64_t n = (w & ~(mask << shift)) | (value << shift);
+        uint8_t  m = (uint8_t)(mask >> (64 - shift));
+        uint8_t  b = (p[8] & ~m) | (uint8_t)(value >> (64 - shift));
+        if (n == w && b == p[8]) return false;
+        _store_le(p, 8, n);
+        p[8] = b;
+    }
+    return true;
+}
+
+static inline uint64_t _unpack_word(const uint8_t* p, uint8_t order,
+    size_t count, size_t shift, uint64_t mask, bool is_signed)
+{
+    uint64_t value;
+    if (order == PduByteOrderBigEndian) {
+        value = _load_be(p, count) >> shift;
+    } else if (LIKELY(count <= 8)) {
+        value = _load_le(p, count) >> shift;
+    } else {
+        /* Word extends into a 9th byte (shift > 0). */
+        value = (_load_le(p, 8) >> shift) | ((uint64_t)p[8] << (64 - shift));
+    }
+    value &= mask;
+    /* Sign extend (two's complement). */
+    if (is_signed && (value & ~(mask >> 1))) value |= ~mask;
+    return value;
+}
+
+
+static int _sort_mux_group(const void* left, const void* right)
+{
+    const PduMuxGroup* l = left;
+    const PduMuxGroup* r = right;
+    if (l->value < r->value) return -1;
+    if (l->value > r->value) return 1;
+    return 0;
+}
+
+/* Select the active group of multiplexed signals, returns the previously
+active group if the selection changed (otherwise NULL). */
+static PduMuxGroup* _mux_select(
+    PduNetworkDesc* net, PduObject* o, uint64_t value, bool* changed)
+{
+    PduMuxGroup* groups = vector_at(&o->mux.group, 0, NULL);
+    size_t       count = vector_len(&o->mux.group);
+    PduMuxGroup* g = NULL;
+    if (value <= UINT32_MAX) {
+        g = bsearch(&(PduMuxGroup){ .value = value }, groups, count,
+            sizeof(PduMuxGroup), _sort_mux_group);
+    }
+    size_t active = (g) ? (size_t)(g - groups) : SIZE_MAX;
+    *changed = (active != o->mux.active);
+    if (*changed == false) return NULL;
+
+    uint8_t* inactive = vector_at(&net->matrix.signal.inactive, 0, NULL);
+    PduMuxGroup* prev = NULL;
+    if (o->mux.active != SIZE_MAX) {
+        prev = &groups[o->mux.active];
+        memset(inactive + prev->offset, 1, prev->count);
+    }
+    if (g) memset(inactive + g->offset, 0, g->count);
+    o->mux.active = active;
+    log_trace("Mux: Pdu[%u]: selector=%u, group=%d", o->matrix.pdu_idx,
+        (unsigned)value, (g) ? (int)active : -1);
+    return prev;
+}
+
 void pdunet_pdu_pack_range(PduNetworkDesc* net, PduRange* r)
 {
     assert(net);
@@ -452,79 +852,54 @@ void pdunet_pdu_pack_range(PduNetworkDesc* net, PduRange* r)
     ModelInstancePrivate* mip = net->mi->private;
     lua_State*            L = mip->lua_state;
 
-    size_t* pdu_idx =
-        (size_t*)vector_at(&net->matrix.signal.pdu_idx, r->offset, NULL);
-    size_t* signal_idx =
-        (size_t*)vector_at(&net->matrix.signal.signal_idx, r->offset, NULL);
-    uint64_t* raw =
-        (uint64_t*)vector_at(&net->matrix.signal.raw, r->offset, NULL);
-    uint16_t* start =
-        (uint16_t*)vector_at(&net->matrix.signal.start_bit, r->offset, NULL);
-    uint16_t* length =
-        (uint16_t*)vector_at(&net->matrix.signal.length_bits, r->offset, NULL);
+    // clang-format off
+    size_t* pdu_idx = (size_t*)vector_at(&net->matrix.signal.pdu_idx, r->offset, NULL);
+    uint64_t* raw = (uint64_t*)vector_at(&net->matrix.signal.raw, r->offset, NULL);
+    bool* is_signed = (bool*)vector_at(&net->matrix.signal.is_signed, r->offset, NULL);
+    uint8_t* order = (uint8_t*)vector_at(&net->matrix.signal.byte_order, r->offset, NULL);
+    uint16_t* offset = (uint16_t*)vector_at(&net->matrix.signal.byte_offset, r->offset, NULL);
+    uint8_t* count = (uint8_t*)vector_at(&net->matrix.signal.byte_count, r->offset, NULL);
+    uint8_t* shift = (uint8_t*)vector_at(&net->matrix.signal.shift, r->offset, NULL);
+    uint64_t* mask = (uint64_t*)vector_at(&net->matrix.signal.mask, r->offset, NULL);
+    uint8_t** payloads = (uint8_t**)vector_at(&net->matrix.payload, 0, NULL);
+    PduObject* pdus = (PduObject*)vector_at(&net->matrix.pdu, 0, NULL);
+    // clang-format on
 
     switch (r->dir) {
     case PduDirectionTx:
-        /* Pack from raw to payload. */
-        for (size_t i = 0; i < r->length; i++) {
-            size_t   bit_count = 0;
-            size_t   byte_idx = start[i] / 8;
-            uint64_t value = raw[i];
-            uint8_t* payload = NULL;
-            vector_at(&(net->matrix.payload), pdu_idx[i], &payload);
-            PduObject*     o = vector_at(&(net->matrix.pdu), pdu_idx[i], NULL);
-            PduSignalItem* s = vector_at(&o->pdu->signals, signal_idx[i], NULL);
-            log_trace("Write Payload[%u][%s]: start=%u, length=%u, value=%08x",
-                pdu_idx[i], s->name, start[i], length[i], value);
-
-            if (start[i] % 8 != 0) {
-                // Write the first N bits at O bit offset.
-                size_t  O = start[i] % 8;
-                size_t  N = ((8 - O) > length[i]) ? length[i] : 8 - O;
-                uint8_t M_p = ((1u << N) - 1u) << (O);
-                uint8_t M_v = ((1u << N) - 1u);
-                uint8_t V = ((uint8_t)value & M_v) << (O);
-                payload[byte_idx] = (payload[byte_idx] & ~M_p) | V;
-                log_trace("  Write[%u]=%02x O=%u, N=%u, M_p=%02x, M_v=%02x, "
-                          "value=%08x",
-                    byte_idx, V, O, N, M_p, M_v, value);
-                byte_idx++;
-                bit_count += N;
-                value = value >> N;
+        /* Select multiplexed signals (selector was encoded), the signals of
+        a deselected group are cleared from the payload. */
+        for (size_t _ = 0; _ < vector_len(&r->mux_list); _++) {
+            PduObject* o = &pdus[*(size_t*)vector_at(&r->mux_list, _, NULL)];
+            bool       changed;
+            PduMuxGroup* prev =
+                _mux_select(net, o, raw[o->mux.selector - r->offset], &changed);
+            if (changed) o->changed = true;
+            if (prev == NULL) continue;
+            for (size_t i = prev->offset - r->offset;
+                i < prev->offset - r->offset + prev->count; i++) {
+                uint8_t* p = payloads[pdu_idx[i]] + offset[i];
+                _pack_word(p, order[i], count[i], shift[i], mask[i], 0);
             }
-            while (bit_count + 8 < length[i]) {
-                size_t  O = 0;
-                size_t  N = 8;
-                uint8_t M_p = 0xff;
-                uint8_t M_v = 0xff;
-                uint8_t V = (uint8_t)value;
-                payload[byte_idx] = V;
-                log_trace("  Write[%u]=%02x O=%u, N=%u, M_p=%02x, M_v=%02x, "
-                          "value=%08x",
-                    byte_idx, V, O, N, M_p, M_v, value);
-                byte_idx++;
-                bit_count += 8;
-                value = value >> 8;
-            }
-            if (bit_count < length[i]) {
-                // Write the last N bits.
-                size_t  O = 0;
-                size_t  N = length[i] - bit_count;
-                uint8_t M_p = ((1u << N) - 1u) << (O);
-                uint8_t M_v = ((1u << N) - 1u);
-                uint8_t V = ((uint8_t)value & M_v) << (O);
-                payload[byte_idx] = (payload[byte_idx] & ~M_p) | V;
-                log_trace("  Write[%u]=%02x O=%u, N=%u, M_p=%02x, M_v=%02x, "
+        }
+        /* Pack from raw to payload, marking PDUs with changed payloads. */
+        for (RangeSpan s = {}; _range_span(net, r, &s);) {
+            for (size_t i = s.begin; i < s.end; i++) {
+                uint8_t* p = payloads[pdu_idx[i]] + offset[i];
+                if (_pack_word(
+                        p, order[i], count[i], shift[i], mask[i], raw[i])) {
+                    pdus[pdu_idx[i]].changed = true;
+                }
+                log_trace("Write Payload[%u]: offset=%u, count=%u, shift=%u, "
                           "value=%08x",
-                    byte_idx, V, O, N, M_p, M_v, value);
+                    pdu_idx[i], offset[i], count[i], shift[i], raw[i]);
             }
         }
         /* Call Lua functions, modify payload. */
         for (size_t i = 0; i < vector_len(&r->pdu_list); i++) {
             size_t pdu_idx = 0;
             vector_at(&r->pdu_list, i, &pdu_idx);
-            uint8_t* payload = NULL;
-            vector_at(&(net->matrix.payload), pdu_idx, &payload);
+            uint8_t*   payload = payloads[pdu_idx];
             PduObject* o = vector_at(&(net->matrix.pdu), pdu_idx, NULL);
             if (o->lua.encode_ref > 0) {
                 log_trace("Lua Call: PDU Pack Tx[%u]: func=%d", pdu_idx,
@@ -539,8 +914,7 @@ void pdunet_pdu_pack_range(PduNetworkDesc* net, PduRange* r)
         for (size_t i = 0; i < vector_len(&r->pdu_list); i++) {
             size_t pdu_idx = 0;
             vector_at(&r->pdu_list, i, &pdu_idx);
-            uint8_t* payload = NULL;
-            vector_at(&(net->matrix.payload), pdu_idx, &payload);
+            uint8_t*   payload = payloads[pdu_idx];
             PduObject* o = vector_at(&(net->matrix.pdu), pdu_idx, NULL);
             if (o->lua.decode_ref > 0) {
                 log_trace("Lua Call: PDU Unpack Rx[%u]: func=%d", pdu_idx,
@@ -549,55 +923,26 @@ void pdunet_pdu_pack_range(PduNetworkDesc* net, PduRange* r)
                     L, o->lua.decode_ref, payload, o->pdu->length, false);
             }
         }
+        /* Select multiplexed signals (selector unpacked first). */
+        for (size_t _ = 0; _ < vector_len(&r->mux_list); _++) {
+            PduObject* o = &pdus[*(size_t*)vector_at(&r->mux_list, _, NULL)];
+            size_t     i = o->mux.selector - r->offset;
+            uint8_t*   p = payloads[pdu_idx[i]] + offset[i];
+            bool       changed;
+            raw[i] = _unpack_word(
+                p, order[i], count[i], shift[i], mask[i], is_signed[i]);
+            _mux_select(net, o, raw[i], &changed);
+        }
         /* Unpack from payload to raw. */
-        for (size_t i = 0; i < r->length; i++) {
-            size_t   bit_count = 0;
-            size_t   byte_idx = start[i] / 8;
-            uint64_t value = 0;
-            uint8_t* payload = NULL;
-            vector_at(&(net->matrix.payload), pdu_idx[i], &payload);
-            PduObject*     o = vector_at(&(net->matrix.pdu), pdu_idx[i], NULL);
-            PduSignalItem* s = vector_at(&o->pdu->signals, signal_idx[i], NULL);
-            log_trace("Read Payload[%u][%s]: start=%u, length=%u", pdu_idx[i],
-                s->name, start[i], length[i]);
-
-            if (start[i] % 8 != 0) {
-                // Read the first N bits at O bit offset.
-                size_t  O = start[i] % 8;
-                size_t  N = ((8 - O) > length[i]) ? length[i] : 8 - O;
-                uint8_t M_v = ((1u << N) - 1u);
-                uint8_t V = (payload[byte_idx] >> O) & M_v;
-                value = V;
-                log_trace("  Read[%u]=%02x O=%u, N=%u, M_v=%02x, payload=%02x, "
-                          "value=%08x",
-                    byte_idx, V, O, N, M_v, payload[byte_idx], value);
-                byte_idx++;
-                bit_count += N;
-            }
-            while (bit_count + 8 < length[i]) {
-                size_t  O = 0;
-                size_t  N = 8;
-                uint8_t M_v = 0xff;
-                uint8_t V = payload[byte_idx];
-                value |= ((uint64_t)V << bit_count);
-                log_trace("  Read[%u]=%02x O=%u, N=%u, M_v=%02x, payload=%02x, "
-                          "value=%08x",
-                    byte_idx, V, O, N, M_v, payload[byte_idx], value);
-                byte_idx++;
-                bit_count += 8;
-            }
-            if (bit_count < length[i]) {
-                // Read the last N bits.
-                size_t  O = 0;
-                size_t  N = length[i] - bit_count;
-                uint8_t M_v = ((1u << N) - 1u);
-                uint8_t V = (payload[byte_idx] >> O) & M_v;
-                value |= ((uint64_t)V << bit_count);
-                log_trace("  Read[%u]=%02x O=%u, N=%u, M_v=%02x, payload=%02x, "
+        for (RangeSpan s = {}; _range_span(net, r, &s);) {
+            for (size_t i = s.begin; i < s.end; i++) {
+                uint8_t* p = payloads[pdu_idx[i]] + offset[i];
+                raw[i] = _unpack_word(
+                    p, order[i], count[i], shift[i], mask[i], is_signed[i]);
+                log_trace("Read Payload[%u]: offset=%u, count=%u, shift=%u, "
                           "value=%08x",
-                    byte_idx, V, O, N, M_v, payload[byte_idx], value);
+                    pdu_idx[i], offset[i], count[i], shift[i], raw[i]);
             }
-            raw[i] = value;
         }
         break;
     default:
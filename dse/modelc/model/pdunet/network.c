@@ -2,6 +2,11 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include <string.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <nmmintrin.h>
+#define PDUNET_CRC32C_SSE42
+#endif
 #include <dse/modelc/model/pdunet/network.h>
 #include <dse/modelc/controller/model_private.h>
 #include <dse/modelc/schema.h>
@@ -11,17 +16,104 @@
 #define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
 
 
+// CRC32C (Castagnoli, reflected polynomial 0x82F63B78), nibble table.
+static const uint32_t crc32c_table[16] = {
+    0x00000000, 0x105EC76F, 0x20BD8EDE, 0x30E349B1, 0x417B1DBC, 0x5125DAD3,
+    0x61C69362, 0x7198540D, 0x82F63B78, 0x92A8FC17, 0xA24BB5A6, 0xB21572C9,
+    0xC38D26C4, 0xD3D3E1AB, 0xE330A81A, 0xF36E6F75
+};
+
+static uint32_t _crc32c_sw(uint32_t crc, const uint8_t* p, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        crc ^= p[i];
+        crc = (crc >> 4) ^ crc32c_table[crc & 0x0f];
+        crc = (crc >> 4) ^ crc32c_table[crc & 0x0f];
+    }
+    return crc;
+}
+
+#if defined(PDUNET_CRC32C_SSE42)
+__attribute__((target("sse4.2"))) static uint32_t _crc32c_sse42(
+    uint32_t crc, const uint8_t* p, size_t len)
+{
+#if defined(__x86_64__)
+    for (; len >= 8; p += 8, len -= 8) {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        crc = (uint32_t)_mm_crc32_u64(crc, v);
+    }
+#endif
+    for (; len >= 4; p += 4, len -= 4) {
+        uint32_t v;
+        memcpy(&v, p, 4);
+        crc = _mm_crc32_u32(crc, v);
+    }
+    for (; len; p++, len--) {
+        crc = _mm_crc32_u8(crc, *p);
+    }
+    return crc;
+}
+#endif
+
 uint32_t pdunet_checksum(const uint8_t* payload, size_t len)
 {
     if (payload == NULL) return 0;
 
-    // FNV-1a hash (http://www.isthe.com/chongo/tech/comp/fnv/)
-    uint32_t csum = 2166136261UL; /* FNV_OFFSET 32 bit */
-    for (size_t i = 0; i < len; ++i) {
-        csum = csum ^ payload[i];
-        csum = csum * 16777619UL; /* FNV_PRIME 32 bit */
+    uint32_t crc = 0xffffffff;
+#if defined(PDUNET_CRC32C_SSE42)
+    if (__builtin_cpu_supports("sse4.2")) {
+        return _crc32c_sse42(crc, payload, len) ^ 0xffffffff;
+    }
+#endif
+    return _crc32c_sw(crc, payload, len) ^ 0xffffffff;
+}
+
+static int _sort_index(const void* left, const void* right)
+{
+    const PduIndexItem* l = left;
+    const PduIndexItem* r = right;
+    if (l->id < r->id) return -1;
+    if (l->id > r->id) return 1;
+    /* Equal ids are ordered by position (qsort is not stable). */
+    if (l->idx < r->idx) return -1;
+    if (l->idx > r->idx) return 1;
+    return 0;
+}
+
+Vector pdunet_index_make(size_t capacity)
+{
+    return vector_make(sizeof(PduIndexItem), capacity, _sort_index);
+}
+
+PduIndexItem* pdunet_index_find(Vector* index, uint32_t id, size_t* count)
+{
+    assert(index);
+    assert(count);
+    *count = 0;
+    size_t len = vector_len(index);
+    if (len == 0) return NULL;
+
+    /* Binary search for the first item with id (index is sorted). */
+    PduIndexItem* items = index->items;
+    size_t        lo = 0;
+    size_t        hi = len;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (items[mid].id < id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
     }
-    return csum;
+    if (lo == len || items[lo].id != id) return NULL;
+
+    /* Several PDUs may share an id. */
+    size_t n = 1;
+    while ((lo + n) < len && items[lo + n].id == id)
+        n++;
+    *count = n;
+    return &items[lo];
 }
 
 static void _set_skip(
@@ -33,89 +125,201 @@ static void _set_skip(
     }
 }
 
-void pdunet_schedule(PduNetworkDesc* net)
+static void _queue_sift_down(PduScheduleItem* q, size_t len, size_t i)
 {
-    /* Signals not calculated. */
+    while (1) {
+        size_t l = 2 * i + 1;
+        size_t r = l + 1;
+        size_t m = i;
+        if (l < len && q[l].due < q[m].due) m = l;
+        if (r < len && q[r].due < q[m].due) m = r;
+        if (m == i) return;
+        PduScheduleItem t = q[i];
+        q[i] = q[m];
+        q[m] = t;
+        i = m;
+    }
+}
+
+static uint32_t _next_due(uint32_t base, uint32_t interval, uint32_t time)
+{
+    if (time <= base) return base;
+    uint32_t delta = (time - base) % interval;
+    return (delta == 0) ? time : time + (interval - delta);
+}
+
+static int32_t _epoch_offset(PduNetworkDesc* net)
+{
+    if (net->schedule.step_size == 0) return 0;
+    return net->schedule.epoch_offset / net->schedule.step_size;
+}
+
+void pdunet_schedule_reset(PduNetworkDesc* net)
+{
+    vector_reset(&net->schedule.tx.queue);
+    vector_reset(&net->schedule.tx.on_change);
+    vector_reset(&net->schedule.tx.active);
+    net->schedule.tx.valid = false;
+    net->schedule.tx.pending = false;
+    net->schedule.tx.every_step = false;
+}
+
+static void _schedule_build(PduNetworkDesc* net, int32_t epoch_offset)
+{
+    uint32_t time = net->schedule.simulation_time;
+    size_t   pdu_count = vector_len(&net->matrix.pdu);
+
+    pdunet_schedule_reset(net);
+    net->schedule.tx.queue = vector_make(sizeof(PduScheduleItem), 0, NULL);
+    net->schedule.tx.on_change = vector_make(sizeof(size_t), 0, NULL);
+    net->schedule.tx.active = vector_make(sizeof(size_t), pdu_count, NULL);
+    net->schedule.tx.epoch_offset = epoch_offset;
+    net->schedule.tx.valid = true;
+    log_trace("Schedule TX: build @ %u: epoch_offset=%d", time, epoch_offset);
+
+    /* Signals not calculated (until a PDU is scheduled). */
     _set_skip(net, 0, net->matrix.signal.count, true);
 
-    for (size_t pdu_idx = 0; pdu_idx < vector_len(&net->matrix.pdu);
-        pdu_idx++) {
+    for (size_t pdu_idx = 0; pdu_idx < pdu_count; pdu_idx++) {
         PduObject* o = vector_at(&(net->matrix.pdu), pdu_idx, NULL);
         if (o->pdu->dir != PduDirectionTx) continue;
 
         /* No schedule, Tx on-change only. */
         if (o->schedule.interval == 0) {
-            if (o->container.header != HeaderFormatNone) {
-                /* Container PDU. */
-                /* Call to pdunet_visit_container_mapto() will evaluate the
-                Container PDU and adjust needs_tx/checksum accordingly. */
-                o->needs_tx = true;
-                continue;
-            } else {
-                /* PDU / I-PDU. */
-                /* Always calculate signals (and send PDU's if the
-                 resultant payload has changed). */
-                log_trace("Schedule TX: PDU %u: on_change", o->pdu->id);
-                _set_skip(
-                    net, o->matrix.range.offset, o->matrix.range.count, false);
-                continue;
+            vector_push(&net->schedule.tx.on_change, &pdu_idx);
+            /* Lua encode may change the payload without a signal change. */
+            if (o->lua.encode_ref > 0) net->schedule.tx.every_step = true;
+            lua_func_t* encode = vector_at(
+                &net->matrix.signal.encode, o->matrix.range.offset, NULL);
+            for (size_t i = 0; encode && i < o->matrix.range.count; i++) {
+                if (encode[i] > 0) net->schedule.tx.every_step = true;
             }
+            continue;
         }
 
-        /* Schedule: determine if schedule will fire. */
-        int32_t epoch_offset =
-            (net->schedule.step_size)
-                ? net->schedule.epoch_offset / net->schedule.step_size
-                : 0;
+        /* Schedule: first due time (a negative base never fires). */
         int32_t base = epoch_offset + o->schedule.phase;
-        log_trace("Schedule TX: PDU %u @ %u: base=%d, epoch_offset=%d, "
-                  "phase=%u, interval=%u",
-            o->pdu->id, net->schedule.simulation_time, base, epoch_offset,
-            o->schedule.phase, o->schedule.interval);
-
-        /* Schedule: did not fire.*/
-        if (base < 0 || net->schedule.simulation_time < (uint32_t)base) {
-            if (o->checksum == 0) {
-                log_trace("Schedule TX: PDU %u: pending", o->pdu->id);
-            } else {
-                log_trace("Schedule TX: PDU %u: wait", o->pdu->id);
-            }
-            continue;
-        }
-        uint32_t delta = net->schedule.simulation_time - base;
-        if (delta % o->schedule.interval != 0) {
-            if (o->checksum == 0) {
-                log_trace("Schedule TX: PDU %u: pending", o->pdu->id);
-            } else {
-                log_trace("Schedule TX: PDU %u: wait", o->pdu->id);
-            }
-            continue;
-        }
+        if (base < 0) continue;
+        uint32_t due = _next_due(base, o->schedule.interval, time);
+        vector_push(&net->schedule.tx.queue,
+            &(PduScheduleItem){ .due = due, .pdu_idx = pdu_idx });
+        log_trace("Schedule TX: PDU %u: base=%d, phase=%u, interval=%u, "
+                  "due=%u",
+            o->pdu->id, base, o->schedule.phase, o->schedule.interval, due);
+    }
 
-        /* Schedule: fired. */
+    /* Heapify the queue. */
+    PduScheduleItem* q = net->schedule.tx.queue.items;
+    size_t           len = vector_len(&net->schedule.tx.queue);
+    for (size_t i = len / 2; i > 0; i--) {
+        _queue_sift_down(q, len, i - 1);
+    }
+}
 
-        /* Container PDU. */
+static void _schedule_fire(PduNetworkDesc* net, PduObject* o)
+{
+    /* Container PDU. */
+    if (o->container.header != HeaderFormatNone) {
+        /* Call to pdunet_visit_container_mapto() will evaluate
+        the Container PDU and adjust needs_tx/checksum accordingly. */
+        log_trace("Schedule TX: Container PDU %u: trigger", o->pdu->id);
+        o->needs_tx = true;
+        return;
+    }
+
+    /* PDU / I-PDU. */
+    _set_skip(net, o->matrix.range.offset, o->matrix.range.count, false);
+    vector_push(&net->schedule.tx.active, &o->matrix.pdu_idx);
+    if (o->schedule.trigger == PduScheduleTriggerPeriodic) {
+        /* Periodic Schedule: PDU Tx occurs according to the schedule. */
+        log_trace("Schedule TX: PDU %u: trigger - periodic", o->pdu->id);
+        o->checksum = 0; /* Force Tx according to schedule. */
+    } else {
+        /* On Change Schedule: PDU Tx only if signals have changed. */
+        log_trace("Schedule TX: PDU %u: trigger - change ", o->pdu->id);
+    }
+}
+
+void pdunet_schedule(PduNetworkDesc* net)
+{
+    uint32_t time = net->schedule.simulation_time;
+    int32_t  epoch_offset = _epoch_offset(net);
+
+    /* Queue is built on first use and rebuilt if the epoch shifts or time
+    moves backwards. */
+    if (net->schedule.tx.valid == false ||
+        net->schedule.tx.epoch_offset != epoch_offset ||
+        time < net->schedule.tx.simulation_time) {
+        _schedule_build(net, epoch_offset);
+    }
+    net->schedule.tx.simulation_time = time;
+
+    /* Signals of PDUs scheduled in the previous step are not calculated. */
+    for (size_t i = 0; i < vector_len(&net->schedule.tx.active); i++) {
+        size_t pdu_idx = *(size_t*)vector_at(&net->schedule.tx.active, i, NULL);
+        PduObject* o = vector_at(&(net->matrix.pdu), pdu_idx, NULL);
+        _set_skip(net, o->matrix.range.offset, o->matrix.range.count, true);
+    }
+    vector_clear(&net->schedule.tx.active, NULL, NULL);
+
+    /* No schedule, Tx on-change only. */
+    for (size_t i = 0; i < vector_len(&net->schedule.tx.on_change); i++) {
+        size_t pdu_idx =
+            *(size_t*)vector_at(&net->schedule.tx.on_change, i, NULL);
+        PduObject* o = vector_at(&(net->matrix.pdu), pdu_idx, NULL);
         if (o->container.header != HeaderFormatNone) {
-            /* Call to pdunet_visit_container_mapto() will evaluate
-            the Container PDU and adjust needs_tx/checksum accordingly. */
-            log_trace("Schedule TX: Container PDU %u: trigger", o->pdu->id);
+            /* Container PDU. */
+            /* Call to pdunet_visit_container_mapto() will evaluate the
+            Container PDU and adjust needs_tx/checksum accordingly. */
             o->needs_tx = true;
-            continue;
+        } else {
+            /* PDU / I-PDU. */
+            /* Always calculate signals (and send PDU's if the
+             resultant payload has changed). */
+            log_trace("Schedule TX: PDU %u: on_change", o->pdu->id);
+            _set_skip(
+                net, o->matrix.range.offset, o->matrix.range.count, false);
+            vector_push(&net->schedule.tx.active, &pdu_idx);
         }
+    }
 
-        /* PDU / I-PDU. */
-        _set_skip(net, o->matrix.range.offset, o->matrix.range.count, false);
-        if (o->schedule.trigger == PduScheduleTriggerPeriodic) {
-            /* Periodic Schedule: PDU Tx occurs according to the schedule. */
-            log_trace("Schedule TX: PDU %u: trigger - periodic", o->pdu->id);
-            o->checksum = 0; /* Force Tx according to schedule. */
+    /* Schedule: only PDUs which are due. */
+    PduScheduleItem* q = net->schedule.tx.queue.items;
+    size_t           len = vector_len(&net->schedule.tx.queue);
+    while (len && q[0].due <= time) {
+        PduObject* o = vector_at(&(net->matrix.pdu), q[0].pdu_idx, NULL);
+        if (q[0].due == time) {
+            /* Schedule: fired. */
+            _schedule_fire(net, o);
+            q[0].due += o->schedule.interval;
         } else {
-            /* On Change Schedule: PDU Tx only if signals have changed. */
-            log_trace("Schedule TX: PDU %u: trigger - change ", o->pdu->id);
+            /* Steps were skipped, align to the next interval. */
+            int32_t base = epoch_offset + o->schedule.phase;
+            q[0].due = _next_due(base, o->schedule.interval, time);
         }
+        _queue_sift_down(q, len, 0);
     }
 }
 
+bool pdunet_schedule_idle(PduNetworkDesc* net)
+{
+    uint32_t time = net->schedule.simulation_time;
+
+    /* Queue (re)build is pending. */
+    if (net->schedule.tx.valid == false ||
+        net->schedule.tx.epoch_offset != _epoch_offset(net) ||
+        time < net->schedule.tx.simulation_time) {
+        return false;
+    }
+    if (net->schedule.tx.pending || net->schedule.tx.every_step) return false;
+
+    /* Head of the queue is the next due PDU. */
+    PduScheduleItem* q = net->schedule.tx.queue.items;
+    if (vector_len(&net->schedule.tx.queue) && q[0].due <= time) return false;
+
+    return true;
+}
+
 
 PduNetworkNCodecVTable pdunet_network_factory(PduNetworkDesc* net)
 {
@@ -189,6 +393,12 @@ PduItem pdunet_pdu_generator(PduNetworkDesc* net, YamlNode* n)
         { "Periodic", PduScheduleTriggerPeriodic },
         { NULL },
     };
+    static const SchemaFieldMapSpec e2e_map[] = {
+        { "CRC8", PduE2eProfileCrc8 },
+        { "CRC16", PduE2eProfileCrc16 },
+        { "CRC32", PduE2eProfileCrc32 },
+        { NULL },
+    };
     static const SchemaFieldSpec spec[] = {
         // clang-format off
         { S, "pdu", offsetof(PduItem, name) },
@@ -201,9 +411,17 @@ PduItem pdunet_pdu_generator(PduNetworkDesc* net, YamlNode* n)
         { D, "schedule/phase", offsetof(PduItem, schedule.phase) },
         { D, "schedule/interval", offsetof(PduItem, schedule.interval) },
         { U8, "schedule/trigger", offsetof(PduItem, schedule.trigger),  trigger_map },
+        { U8, "e2e/profile", offsetof(PduItem, e2e.profile), e2e_map },
+        { U16, "e2e/data_id", offsetof(PduItem, e2e.data_id) },
+        { U16, "e2e/crc_offset", offsetof(PduItem, e2e.crc_offset) },
+        { U16, "e2e/counter/offset", offsetof(PduItem, e2e.counter.offset) },
+        { U8, "e2e/counter/bits", offsetof(PduItem, e2e.counter.bits) },
+        { S, "route/network", offsetof(PduItem, route.network) },
+        { S, "route/pdu", offsetof(PduItem, route.pdu) },
         // clang-format on
     };
     schema_load_object(n, &pdu, spec, ARRAY_SIZE(spec));
+    pdunet_e2e_validate(&pdu);
     pdunet_load_lua_func(n, "functions/encode", &pdu.lua.encode);
     pdunet_load_lua_func(n, "functions/decode", &pdu.lua.decode);
     pdunet_load_lua_func(n, "functions/tx", &pdu.lua.tx);
@@ -242,19 +460,38 @@ PduSignalItem pdunet_signal_generator(
         .max = NAN,
         .start_bit = 0xffff };
 
+    static const SchemaFieldMapSpec byte_order_map[] = {
+        { "LittleEndian", PduByteOrderLittleEndian },
+        { "BigEndian", PduByteOrderBigEndian },
+        { "Intel", PduByteOrderLittleEndian },
+        { "Motorola", PduByteOrderBigEndian },
+        { NULL },
+    };
     static const SchemaFieldSpec spec[] = {
         // clang-format off
         { S, "signal", offsetof(PduSignalItem, name) },
         // Encoding parameters.
         { U16, "encoding/start", offsetof(PduSignalItem, start_bit) },
         { U16, "encoding/length", offsetof(PduSignalItem, length_bits) },
+        { U8, "encoding/byte_order", offsetof(PduSignalItem, byte_order), byte_order_map },
+        { B, "encoding/signed", offsetof(PduSignalItem, is_signed) },
         { D, "encoding/factor", offsetof(PduSignalItem, factor) },
         { D, "encoding/offset", offsetof(PduSignalItem, offset) },
         { D, "encoding/min", offsetof(PduSignalItem, min) },
         { D, "encoding/max", offsetof(PduSignalItem, max) },
+        // Multiplexing.
+        { B, "multiplex/selector", offsetof(PduSignalItem, mux.selector) },
+        { U32, "multiplex/value", offsetof(PduSignalItem, mux.value) },
         // clang-format on
     };
     schema_load_object(n, &signal, spec, ARRAY_SIZE(spec));
+    signal.mux.muxed = (dse_yaml_find_node(n, "multiplex/value") != NULL);
+    if (signal.mux.selector && signal.mux.muxed) {
+        if (__log_level__ != LOG_QUIET)
+            log_error("Invalid signal multiplex: selector is multiplexed (%s)",
+                signal.name);
+        signal.mux.muxed = false;
+    }
 
     bool is_valid = true;
     if (signal.factor == 0.0) {
@@ -281,13 +518,28 @@ PduSignalItem pdunet_signal_generator(
                 signal.name);
         is_valid = false;
     }
-    if ((signal.start_bit + signal.length_bits) > (pdu->length * 8)) {
+    if (signal.length_bits > 64) {
+        if (__log_level__ != LOG_QUIET)
+            log_error("Invalid signal encoding: length exceeds 64 bits (%s)",
+                signal.name);
+        is_valid = false;
+    }
+    if (signal.byte_order == PduByteOrderLittleEndian &&
+        (signal.start_bit + signal.length_bits) > (pdu->length * 8)) {
         if (__log_level__ != LOG_QUIET)
             log_error("Invalid signal encoding: length is beyond payload "
                       "length (%s)",
                 signal.name);
         is_valid = false;
     }
+    if (is_valid && pdunet_signal_layout(&signal, pdu->length,
+                        &(PduSignalLayout){}) != 0) {
+        if (__log_level__ != LOG_QUIET)
+            log_error("Invalid signal encoding: layout is beyond payload "
+                      "length (%s)",
+                signal.name);
+        is_valid = false;
+    }
     if (is_valid == false) {
         signal.name = NULL;  // Caller will reject.
     }
@@ -299,6 +551,40 @@ PduSignalItem pdunet_signal_generator(
 }
 
 
+static int _sort_marshal_run(const void* left, const void* right)
+{
+    const PduMarshalRun* l = left;
+    const PduMarshalRun* r = right;
+    if (l->source < r->source) return -1;
+    if (l->source > r->source) return 1;
+    return 0;
+}
+
+/* Append the copy program of a MSM (runs of signals which are contiguous in
+both the SignalVector and the matrix). */
+static void _build_marshal_runs(Vector* runs, MarshalSignalMap* msm)
+{
+    PduMarshalRun* pairs = calloc(msm->count + 1, sizeof(PduMarshalRun));
+    for (size_t i = 0; i < msm->count; i++) {
+        pairs[i] = (PduMarshalRun){
+            .signal = msm->signal.index[i],
+            .source = msm->source.index[i] + msm->offset,
+            .count = 1,
+        };
+    }
+    qsort(pairs, msm->count, sizeof(PduMarshalRun), _sort_marshal_run);
+    for (size_t i = 0; i < msm->count;) {
+        PduMarshalRun run = pairs[i++];
+        while (i < msm->count && pairs[i].signal == run.signal + run.count &&
+               pairs[i].source == run.source + run.count) {
+            run.count++;
+            i++;
+        }
+        vector_push(runs, &run);
+    }
+    free(pairs);
+}
+
 void pdunet_build_msm(PduNetworkDesc* net, const char* sv_name)
 {
     assert(sv_name);
@@ -314,6 +600,11 @@ void pdunet_build_msm(PduNetworkDesc* net, const char* sv_name)
         break;
     }
     if (sv == NULL) return;
+    net->msm.scalar = sv->scalar;
+    vector_reset(&net->msm.run_in);
+    vector_reset(&net->msm.run_out);
+    net->msm.run_in = vector_make(sizeof(PduMarshalRun), 0, NULL);
+    net->msm.run_out = vector_make(sizeof(PduMarshalRun), 0, NULL);
     MarshalMapSpec signal = (MarshalMapSpec){
         .name = sv->name,
         .count = sv->count,
@@ -351,13 +642,16 @@ void pdunet_build_msm(PduNetworkDesc* net, const char* sv_name)
         /* Save the offset, used when logging the map. */
         msm->offset = r->offset;
 
-        /* Shallow copy the MSM object into a vector. */
+        /* Shallow copy the MSM object into a vector, and build the copy
+        program (used at runtime). */
         switch (r->dir) {
         case PduDirectionRx:
             vector_push(&in, msm);
+            _build_marshal_runs(&net->msm.run_in, msm);
             break;
         case PduDirectionTx:
             vector_push(&out, msm);
+            _build_marshal_runs(&net->msm.run_out, msm);
             break;
         default:
             break;
@@ -372,6 +666,8 @@ void pdunet_build_msm(PduNetworkDesc* net, const char* sv_name)
     /* Use the internal vector objects, which are NTLs. */
     net->msm.in = in.items;
     net->msm.out = out.items;
+    log_debug("MSM copy program: in=%u runs, out=%u runs",
+        vector_len(&net->msm.run_in), vector_len(&net->msm.run_out));
 }
 
 
@@ -409,8 +705,14 @@ static int _network_match_handler(ModelInstanceSpec* mi, SchemaObject* object)
         net->network.vtable.parse_network(net);
     }
 
-    // Parse spec/pdus.
-    pdunet_parse_pdus(net, object);
+    // Parse spec/pdus, or load from the Network Cache (when the hash of
+    // the Network YAML matches).
+    const char* cache = NULL;
+    dse_yaml_get_string(net->doc, "metadata/annotations/cache", &cache);
+    if (cache == NULL || pdunet_cache_load(net, cache) != 0) {
+        pdunet_parse_pdus(net, object);
+        if (cache) pdunet_cache_save(net, cache);
+    }
 
     return 1;
 }
@@ -503,6 +805,34 @@ void pdunet_visit_setup_containers(
     pdu->container.pdu_list = vector_make(sizeof(MPduItem), 4, _sort_mpdu);
     pdunet_visit(net, NULL, pdunet_visit_map_pdu, pdu);
     vector_sort(&pdu->container.pdu_list);
+
+    /* Index the I-PDUs by id (for Rx header lookup). */
+    size_t count = vector_len(&pdu->container.pdu_list);
+    pdu->container.id_index = pdunet_index_make(count);
+    for (size_t i = 0; i < count; i++) {
+        MPduItem* pi = vector_at(&pdu->container.pdu_list, i, NULL);
+        vector_push(&pdu->container.id_index,
+            &(PduIndexItem){ .id = pi->id, .idx = i });
+    }
+    vector_sort(&pdu->container.id_index);
+
+    /* Static layout, I-PDUs are located (by priority) at fixed offsets. */
+    if (pdu->container.header == HeaderFormatStatic) {
+        size_t offset = 0;
+        for (size_t i = 0; i < count; i++) {
+            MPduItem* pi = vector_at(&pdu->container.pdu_list, i, NULL);
+            size_t    len = pi->pdu->pdu->length;
+            if (offset + len > pdu->pdu->length) {
+                log_error("Container: I-PDU[%u] beyond static layout of "
+                          "L-PDU[%u] (offset=%u, len=%u)",
+                    pi->id, pdu->pdu->id, offset, len);
+                pi->offset = PDUNET_STATIC_NONE;
+                continue;
+            }
+            pi->offset = offset;
+            offset += len;
+        }
+    }
 }
 
 static size_t header_length[] = {
@@ -512,6 +842,55 @@ static size_t header_length[] = {
     [HeaderFormatFull] = 8,
 };
 
+
+static void _container_mapto_static(
+    PduNetworkDesc* net, PduObject* pdu, uint8_t* payload)
+{
+    /* Payload retains the previous content of each (fixed) I-PDU. */
+    size_t count = vector_len(&pdu->container.pdu_list);
+    for (size_t i = 0; i < count; i++) {
+        MPduItem* pi = vector_at(&pdu->container.pdu_list, i, NULL);
+        if (pi->offset == PDUNET_STATIC_NONE) continue;
+        if (pi->pdu->needs_tx != true) continue;
+
+        uint8_t* pi_payload = pi->pdu->ncodec.pdu.payload;
+        size_t   len = pi->pdu->pdu->length;
+        pi->pdu->checksum = pdunet_checksum(pi_payload, len);
+        pi->pdu->changed = false;
+        pdunet_call_tx_func(net, pi->pdu);
+        if (pi->pdu->needs_tx == false) continue; /* Rejected. */
+
+        memcpy(payload + pi->offset, pi_payload, len);
+        log_trace("Map to Container: [%u] L-PDU[%u] <-map- [%u] I-PDU[%u], "
+                  "offset=%u, len=%u (static)",
+            pdu->matrix.pdu_idx, pdu->pdu->id, pi->pdu->pdu->id,
+            pi->pdu->matrix.pdu_idx, pi->offset, len);
+        pdu->needs_tx = true;
+        pi->pdu->needs_tx = false;
+    }
+}
+
+
+static void _container_mapfrom_static(
+    PduNetworkDesc* net, PduObject* pdu, uint8_t* payload)
+{
+    size_t count = vector_len(&pdu->container.pdu_list);
+    for (size_t i = 0; i < count; i++) {
+        MPduItem* pi = vector_at(&pdu->container.pdu_list, i, NULL);
+        if (pi->offset == PDUNET_STATIC_NONE) continue;
+
+        uint8_t* p = payload + pi->offset;
+        size_t   len = pi->pdu->pdu->length;
+        int      rc = pdunet_call_rx_func(net, pi->pdu, p, len);
+        if (rc != 0) continue; /* Discarded. */
+        memcpy(pi->pdu->ncodec.pdu.payload, p, len);
+        log_debug("Map from Container: [%u] L-PDU[%u] <-map- [%u] I-PDU[%u], "
+                  "offset=%u, len=%u (static)",
+            pdu->matrix.pdu_idx, pdu->pdu->id, pi->pdu->pdu->id,
+            pi->pdu->matrix.pdu_idx, pi->offset, len);
+    }
+}
+
 void pdunet_visit_container_mapto(
     PduNetworkDesc* net, PduObject* pdu, void* data)
 {
@@ -528,9 +907,14 @@ void pdunet_visit_container_mapto(
     assert(payload);
     size_t payload_len = pdu->pdu->length;
     size_t payload_offset = 0;
-    memset(payload, 0, payload_len);
 
     pdu->needs_tx = false; /* Will be set to true if I-PDU mapped. */
+    if (pdu->container.header == HeaderFormatStatic) {
+        _container_mapto_static(net, pdu, payload);
+        pdunet_call_tx_func(net, pdu);
+        return;
+    }
+    memset(payload, 0, payload_len);
 
     /* I-PDUs (sorted by container.priority). */
     size_t count = vector_len(&pdu->container.pdu_list);
@@ -561,6 +945,7 @@ void pdunet_visit_container_mapto(
         vector_at(&(net->matrix.payload), pi->pdu->matrix.pdu_idx, &pi_payload);
         assert(pi_payload);
         pi->pdu->checksum = pdunet_checksum(pi_payload, len);
+        pi->pdu->changed = false;
 
         /* Apply Tx payload modifications to this I-PDU. */
         pdunet_call_tx_func(net, pi->pdu);
@@ -627,6 +1012,10 @@ void pdunet_visit_container_mapfrom(
     assert(payload);
     size_t payload_len = pdu->pdu->length;
     size_t payload_offset = 0;
+    if (pdu->container.header == HeaderFormatStatic) {
+        _container_mapfrom_static(net, pdu, payload);
+        return;
+    }
 
     while (payload_offset < payload_len) {
         uint32_t id = 0;
@@ -671,12 +1060,14 @@ void pdunet_visit_container_mapfrom(
             break;
         }
         // Locate the I-PDU and copy the payload.
-        size_t count = vector_len(&pdu->container.pdu_list);
+        size_t        count = 0;
+        PduIndexItem* index =
+            pdunet_index_find(&pdu->container.id_index, id, &count);
         for (size_t i = 0; i < count; i++) {
-            MPduItem* pi = vector_at(&pdu->container.pdu_list, i, NULL);
+            MPduItem* pi =
+                vector_at(&pdu->container.pdu_list, index[i].idx, NULL);
             assert(pi);
             assert(pi->pdu);
-            if (pi->id != id) continue;
 
             // I-PDU - call rx function.
             int rc = pdunet_call_rx_func(
@@ -733,6 +1124,7 @@ int pdunet_configure(PduNetworkDesc* net)
     pdunet_parse_network_functions(net);
     if (net->lua.global != NULL) {
         lua_install_script(L, net->lua.global);
+        net->lua.installed = true;
     }
 
     size_t pdu_count = vector_len(&net->pdus);
@@ -750,6 +1142,13 @@ int pdunet_configure(PduNetworkDesc* net)
             // Signal -> install lua func.
             s->lua.encode_ref = lua_install_script(L, s->lua.encode);
             s->lua.decode_ref = lua_install_script(L, s->lua.decode);
+            if (s->lua.encode_ref || s->lua.decode_ref) {
+                net->lua.installed = true;
+            }
+        }
+        if (p->lua.encode_ref || p->lua.decode_ref || p->lua.tx_ref ||
+            p->lua.rx_ref) {
+            net->lua.installed = true;
         }
     }
 
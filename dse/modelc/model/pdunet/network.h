@@ -36,12 +36,66 @@ typedef struct MPduItem {
     uint32_t   id;
     uint16_t   priority;
     PduObject* pdu;
+    size_t     offset; /* Static layout, offset in the L-PDU payload. */
 } MPduItem;
 
+#define PDUNET_STATIC_NONE SIZE_MAX /* I-PDU not in the static layout. */
+
+
+typedef struct PduSignalLayout {
+    uint16_t byte_offset;
+    uint8_t  byte_count;
+    uint8_t  shift;
+    uint64_t mask;
+} PduSignalLayout;
+
+
+typedef struct PduScheduleItem {
+    uint32_t due; /* Normalised (to step_size). */
+    size_t   pdu_idx;
+} PduScheduleItem;
+
+
+/* Run of signals, contiguous in both the SignalVector and the matrix. */
+typedef struct PduMarshalRun {
+    uint32_t signal; /* SignalVector index. */
+    uint32_t source; /* Matrix signal index. */
+    uint32_t count;
+} PduMarshalRun;
+
+
+typedef struct PduIndexItem {
+    uint32_t id;
+    size_t   idx;
+} PduIndexItem;
+
+
+static inline bool pdunet_in_range(PduNetworkDesc* net, PduObject* pdu)
+{
+    return (net->range == NULL || pdu->matrix.pdu_range == net->range);
+}
+
+static inline size_t pdunet_range_count(PduNetworkDesc* net)
+{
+    if (net->range) return vector_len(&net->range->pdu_list);
+    return vector_len(&net->matrix.pdu);
+}
+
+static inline size_t pdunet_range_pdu_idx(PduNetworkDesc* net, size_t i)
+{
+    if (net->range) return *(size_t*)vector_at(&net->range->pdu_list, i, NULL);
+    return i;
+}
+
 
 /* network.c */
+DLL_PRIVATE Vector        pdunet_index_make(size_t capacity);
+DLL_PRIVATE PduIndexItem* pdunet_index_find(
+    Vector* index, uint32_t id, size_t* count);
 DLL_PRIVATE uint32_t pdunet_checksum(const uint8_t* payload, size_t len);
 DLL_PRIVATE void     pdunet_schedule(PduNetworkDesc* net);
+DLL_PRIVATE void     pdunet_schedule_reset(PduNetworkDesc* net);
+DLL_PRIVATE bool     pdunet_schedule_idle(PduNetworkDesc* net);
 DLL_PRIVATE int      pdunet_parse(PduNetworkDesc* net, SchemaLabel* labels);
 DLL_PRIVATE void     pdunet_build_msm(PduNetworkDesc* net, const char* sv_name);
 DLL_PRIVATE int      pdunet_configure(PduNetworkDesc* net);
@@ -65,12 +119,32 @@ DLL_PRIVATE void pdunet_matrix_clear(PduNetworkDesc* net);
 DLL_PRIVATE void pdunet_pdu_calculate_linear_range(
     PduNetworkDesc* net, PduRange* r);
 DLL_PRIVATE void pdunet_pdu_pack_range(PduNetworkDesc* net, PduRange* r);
+DLL_PRIVATE int  pdunet_signal_layout(
+     PduSignalItem* s, size_t pdu_length, PduSignalLayout* layout);
 
 DLL_PRIVATE void pdunet_encode_linear(PduNetworkDesc* net, PduRange* range);
 DLL_PRIVATE void pdunet_decode_linear(PduNetworkDesc* net, PduRange* range);
 DLL_PRIVATE void pdunet_encode_pack(PduNetworkDesc* net, PduRange* range);
 DLL_PRIVATE void pdunet_decode_unpack(PduNetworkDesc* net, PduRange* range);
 
+/* cache.c */
+DLL_PRIVATE uint64_t pdunet_cache_hash(PduNetworkDesc* net);
+DLL_PRIVATE int      pdunet_cache_save(PduNetworkDesc* net, const char* path);
+DLL_PRIVATE int      pdunet_cache_load(PduNetworkDesc* net, const char* path);
+
+/* e2e.c */
+DLL_PRIVATE uint32_t pdunet_e2e_crc(
+    PduE2eProfile profile, const uint8_t* p, size_t len);
+DLL_PRIVATE bool pdunet_e2e_validate(PduItem* pdu);
+DLL_PRIVATE void pdunet_e2e_protect(
+    PduObject* pdu, uint8_t* payload, size_t len);
+DLL_PRIVATE int  pdunet_e2e_check(
+    PduObject* pdu, const uint8_t* payload, size_t len);
+
+/* route.c */
+DLL_PRIVATE bool pdunet_route_pending(PduNetworkDesc* net);
+DLL_PRIVATE void pdunet_route(PduNetworkDesc* net);
+
 /* lua.c */
 DLL_PRIVATE void pdunet_parse_network_functions(PduNetworkDesc* net);
 DLL_PRIVATE void pdunet_load_lua_func(
@@ -81,6 +155,9 @@ DLL_PRIVATE int  pdunet_lua_pdu_call(lua_State* L, int32_t func_ref,
      uint8_t* payload, uint32_t payload_len, bool no_err_log);
 DLL_PRIVATE int  pdunet_lua_signal_call(lua_State* L, int32_t func_ref,
      double* phys, uint64_t* raw, uint8_t* payload, uint32_t payload_len);
+DLL_PRIVATE int  pdunet_lua_signal_range_call(lua_State* L, int32_t func_ref,
+     size_t key, double* phys, uint64_t* raw, size_t count, uint8_t* payload,
+     uint32_t payload_len);
 DLL_PRIVATE void pdunet_lua_teardown(PduNetworkDesc* net);
 
 /* flexray.c */
@@ -0,0 +1,150 @@
+// Copyright 2026 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dse/modelc/model/pdunet/network.h>
+
+
+/*
+PDU Routing
+===========
+
+Route the payload of an Rx PDU, received on another PDU Network, to a Tx PDU.
+The route is configured on the Tx PDU (route/network and route/pdu) and
+linked after all PDU Networks are created. The routed payload is copied
+before the Tx PDU is encoded, so any signals of the Tx PDU are packed over
+(i.e. patch) the routed payload. Container I-PDUs are unwrapped (mapfrom) and
+rewrapped (mapto) by their Container PDUs.
+*/
+
+
+static PduObject* _find_rx_pdu(PduNetworkDesc* net, const char* name)
+{
+    for (size_t i = 0; i < vector_len(&net->matrix.pdu); i++) {
+        PduObject* o = vector_at(&net->matrix.pdu, i, NULL);
+        if (o->pdu->dir != PduDirectionRx) continue;
+        if (o->pdu->name && strcmp(o->pdu->name, name) == 0) return o;
+    }
+    return NULL;
+}
+
+
+/**
+pdunet_route_link
+=================
+
+Link the routes of a PDU Network which are sourced from another PDU Network
+(i.e. route/network matches the name of the source PDU Network).
+
+Parameters
+----------
+net (PduNetworkDesc*)
+: PDU Network object, with routed Tx PDUs.
+
+source (PduNetworkDesc*)
+: PDU Network object, with the source Rx PDUs.
+
+Returns
+-------
+int
+: The number of routes linked.
+*/
+int pdunet_route_link(PduNetworkDesc* net, PduNetworkDesc* source)
+{
+    if (net == NULL || source == NULL || source->name == NULL) return 0;
+
+    int count = 0;
+    for (size_t i = 0; i < vector_len(&net->matrix.pdu); i++) {
+        PduObject* o = vector_at(&net->matrix.pdu, i, NULL);
+        PduItem*   p = o->pdu;
+        if (p->route.network == NULL || p->route.pdu == NULL) continue;
+        if (strcmp(p->route.network, source->name) != 0) continue;
+        if (p->dir != PduDirectionTx || p->container.header) {
+            log_error("Route: not a Tx PDU (or is a Container PDU) (%s)",
+                p->name);
+            continue;
+        }
+        PduObject* src = _find_rx_pdu(source, p->route.pdu);
+        if (src == NULL) {
+            log_error("Route: Rx PDU not found (%s -> %s:%s)", p->name,
+                p->route.network, p->route.pdu);
+            continue;
+        }
+
+        if (o->route.source == NULL) {
+            if (vector_len(&net->route.list) == 0) {
+                vector_reset(&net->route.list);
+                net->route.list = vector_make(sizeof(size_t), 4, NULL);
+            }
+            vector_push(&net->route.list, &o->matrix.pdu_idx);
+        }
+        o->route.source = src;
+        o->route.rx_count = src->route.rx_count;
+        log_notice(
+            "  Route: %s <- %s:%s", p->name, source->name, src->pdu->name);
+        count++;
+    }
+    return count;
+}
+
+
+/**
+pdunet_route_pending
+====================
+
+Parameters
+----------
+net (PduNetworkDesc*)
+: PDU Network object.
+
+Returns
+-------
+true
+: A source PDU was received since the last route (i.e. Tx is required).
+*/
+bool pdunet_route_pending(PduNetworkDesc* net)
+{
+    assert(net);
+    for (size_t i = 0; i < vector_len(&net->route.list); i++) {
+        size_t     pdu_idx = *(size_t*)vector_at(&net->route.list, i, NULL);
+        PduObject* o = vector_at(&net->matrix.pdu, pdu_idx, NULL);
+        if (o->route.rx_count != o->route.source->route.rx_count) return true;
+    }
+    return false;
+}
+
+
+/**
+pdunet_route
+============
+
+Copy the payload of each received source PDU to its routed Tx PDU (in the
+current range), and mark the Tx PDU as changed (forces Tx).
+
+Parameters
+----------
+net (PduNetworkDesc*)
+: PDU Network object.
+*/
+void pdunet_route(PduNetworkDesc* net)
+{
+    assert(net);
+    for (size_t i = 0; i < vector_len(&net->route.list); i++) {
+        size_t     pdu_idx = *(size_t*)vector_at(&net->route.list, i, NULL);
+        PduObject* o = vector_at(&net->matrix.pdu, pdu_idx, NULL);
+        PduObject* src = o->route.source;
+        if (pdunet_in_range(net, o) == false) continue;
+        if (o->route.rx_count == src->route.rx_count) continue;
+
+        size_t len = o->ncodec.pdu.payload_len;
+        if (len > src->ncodec.pdu.payload_len) {
+            len = src->ncodec.pdu.payload_len;
+        }
+        memcpy(o->ncodec.pdu.payload, src->ncodec.pdu.payload, len);
+        o->route.rx_count = src->route.rx_count;
+        o->changed = true;
+        o->checksum = 0;
+        log_trace("Route: Tx[%u] <- Rx[%u], len=%u", o->matrix.pdu_idx,
+            src->matrix.pdu_idx, (unsigned)len);
+    }
+}
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include <errno.h>
 #include <dse/testing.h>
@@ -17,6 +18,7 @@
 
 #define UNUSED(x)                ((void)x)
 #define DEFAULT_BINARY_MIME_TYPE "application/octet-stream"
+#define BINARY_BUFFER_MIN_SIZE   64
 
 
 extern void ncodec_trace_configure(
@@ -191,6 +193,33 @@ static void* __binary_codec_nop(SignalVector* sv, uint32_t index)
     return 0;
 }
 
+/* Reserve space for len bytes after the current length (geometric growth,
+   buffers are retained until released). The length of a binary signal is
+   limited to UINT32_MAX. */
+static uint8_t* _binary_reserve(SignalVector* sv, uint32_t index, size_t len)
+{
+    if (len > UINT32_MAX - sv->length[index]) {
+        errno = ENOMEM;
+        return NULL;
+    }
+    uint32_t required = sv->length[index] + len;
+    if (required > sv->buffer_size[index] || sv->binary[index] == NULL) {
+        uint64_t size = sv->buffer_size[index];
+        if (size < BINARY_BUFFER_MIN_SIZE) size = BINARY_BUFFER_MIN_SIZE;
+        while (size < required)
+            size *= 2;
+        if (size > UINT32_MAX) size = UINT32_MAX;
+        void* buffer = realloc(sv->binary[index], size);
+        if (buffer == NULL) {
+            errno = ENOMEM;
+            return NULL;
+        }
+        sv->binary[index] = buffer;
+        sv->buffer_size[index] = size;
+    }
+    return (uint8_t*)sv->binary[index] + sv->length[index];
+}
+
 static int __binary_append(
     SignalVector* sv, uint32_t index, void* data, uint32_t len)
 {
@@ -198,8 +227,10 @@ static int __binary_append(
         errno = EPROTO;
         log_error("Binary Check: Model did not call Reset before Append!");
     }
-    dse_buffer_append(&sv->binary[index], &sv->length[index],
-        &sv->buffer_size[index], data, len);
+    uint8_t* p = _binary_reserve(sv, index, len);
+    if (p == NULL) return -ENOMEM;
+    if (len) memcpy(p, data, len);
+    sv->length[index] += len;
 
     return 0;
 }
@@ -245,12 +276,39 @@ static const char* __group_annotation_get(
     return _signal_group_annotation(sv->mi, sv, name, node);
 }
 
+/* NCodec objects are created on first use (i.e. the first call to
+   signal_codec()). Signals where creation failed are marked (in the bytes
+   following the NCodec array, see NCODEC_ARRAY_SIZE) so that creation is
+   attempted only once. */
+static inline uint8_t* _ncodec_failed(SignalVector* sv)
+{
+    return (uint8_t*)&sv->ncodec[sv->count];
+}
+
+static void* _ncodec_create(SignalVector* sv, uint32_t index)
+{
+    if (sv->mime_type == NULL || sv->mime_type[index] == NULL) return NULL;
+    if (_ncodec_failed(sv)[index]) return NULL;
+
+    void*   stream = model_sv_stream_create(sv, index);
+    NCODEC* nc = ncodec_open(sv->mime_type[index], stream);
+    if (nc == NULL) {
+        model_sv_stream_destroy(stream);
+        _ncodec_failed(sv)[index] = 1;
+        return NULL;
+    }
+    ncodec_trace_configure(nc, sv->mi, false);
+    sv->ncodec[index] = nc;
+    return nc;
+}
+
 static void* __binary_codec(SignalVector* sv, uint32_t index)
 {
     assert(sv);
     assert(sv->mi);
     assert(index < sv->count);
 
+    if (sv->ncodec[index] == NULL) return _ncodec_create(sv, index);
     return sv->ncodec[index];
 }
 
@@ -305,18 +363,21 @@ static int _add_sv(void* _mfc, void* _sv_data)
                 current_sv->vtable.annotation(current_sv, i, "mime_type", NULL);
             if (mt) current_sv->mime_type[i] = mt;
         }
-        /* NCodec. */
-        current_sv->ncodec = calloc(current_sv->count, sizeof(NCODEC*));
+        /* Buffer size (capacity hint). */
         for (uint32_t i = 0; i < current_sv->count; i++) {
-            void*   stream = model_sv_stream_create(current_sv, i);
-            NCODEC* nc = ncodec_open(current_sv->mime_type[i], stream);
-            if (nc) {
-                ncodec_trace_configure(nc, data->mi, false);
-                current_sv->ncodec[i] = nc;
-            } else {
-                model_sv_stream_destroy(stream);
+            const char* bs = current_sv->vtable.annotation(
+                current_sv, i, "buffer_size", NULL);
+            if (bs == NULL) {
+                bs = current_sv->vtable.group_annotation(
+                    current_sv, "buffer_size", NULL);
             }
+            if (bs == NULL || current_sv->binary[i]) continue;
+            uint32_t size = strtoul(bs, NULL, 0);
+            if (size) _binary_reserve(current_sv, i, size);
         }
+        /* NCodec (created on first use, see __binary_codec()). */
+        current_sv->ncodec = calloc(1, NCODEC_ARRAY_SIZE(current_sv->count));
+        current_sv->ncodec_dirty = calloc(current_sv->count, sizeof(bool));
     } else {
         current_sv->is_binary = false;
         current_sv->scalar = mfc->signal_value_double;
@@ -442,6 +503,7 @@ void model_sv_destroy(SignalVector* sv)
                 sv->ncodec[i] = NULL;
             }
             free(sv->ncodec);
+            free(sv->ncodec_dirty);
         }
         if (sv->index) {
             hashmap_destroy(sv->index);
@@ -722,14 +784,103 @@ inline int signal_release(SignalVector* sv, uint32_t index)
 }
 
 
+/**
+signal_reserve
+==============
+
+Reserve space at the end of the specified binary signal, so that data can be
+written (encoded) directly into the buffer of the binary signal. The written
+data is added to the binary signal by calling `signal_commit()`.
+
+Parameters
+----------
+sv (SignalVector*)
+: The Signal Vector object containing the signal.
+
+index (uint32_t)
+: Index of the signal in the Signal Vector object.
+
+len (size_t)
+: Length of the space to reserve.
+
+data (uint8_t**)
+: (out) Pointer to the reserved space, valid until the next operation on the
+  binary signal.
+
+Returns
+-------
+0
+: The operation completed without error.
+
+-EINVAL (-22)
+: Bad arguments.
+
+-ENOMEM (-12)
+: The buffer of the binary signal could not be resized.
+*/
+int signal_reserve(
+    SignalVector* sv, uint32_t index, size_t len, uint8_t** data)
+{
+    if (data == NULL) return -EINVAL;
+    if (sv && index < sv->count && sv->is_binary) {
+        *data = _binary_reserve(sv, index, len);
+        return (*data) ? 0 : -ENOMEM;
+    } else {
+        return -EINVAL;
+    }
+}
+
+
+/**
+signal_commit
+=============
+
+Commit data, previously written to space reserved with `signal_reserve()`,
+to the specified binary signal.
+
+Parameters
+----------
+sv (SignalVector*)
+: The Signal Vector object containing the signal.
+
+index (uint32_t)
+: Index of the signal in the Signal Vector object.
+
+len (size_t)
+: Length of the data written (not more than the reserved space).
+
+Returns
+-------
+0
+: The operation completed without error.
+
+-EINVAL (-22)
+: Bad arguments.
+*/
+int signal_commit(SignalVector* sv, uint32_t index, size_t len)
+{
+    if (sv && index < sv->count && sv->is_binary) {
+        if (sv->length[index] + len > sv->buffer_size[index]) return -EINVAL;
+        if (sv->reset_called[index] == false) {
+            errno = EPROTO;
+            log_error("Binary Check: Model did not call Reset before Commit!");
+        }
+        sv->length[index] += len;
+        return 0;
+    } else {
+        return -EINVAL;
+    }
+}
+
+
 /**
 signal_codec
 ============
 
 Return a pointer to the Codec object associated with a binary signal.
 
-Codec objects are created when a binary signal is specified with a `mime_type`
-annotation.
+Codec objects are created, on the first call to this function, when a binary
+signal is specified with a `mime_type` annotation.
 
 Parameters
 ----------
@@ -22,7 +22,22 @@
 #define NCT_BUFFER_LEN 2000
 #define NCT_ENVVAR_LEN 100
 #define NCT_ID_LEN     100
-#define NCT_KEY_LEN    20
+
+#define LINKTYPE_USER0         147
+#define LINKTYPE_FLEXRAY       210
+#define LINKTYPE_CAN_SOCKETCAN 227
+#define CAN_EFF_FLAG           0x80000000U
+#define CANFD_FDF              0x04
+#define PCAP_IF_NONE           (-1)
+#define PCAP_IF_ERROR          (-2)
+
+
+typedef enum {
+    PcapIfCan = 0,
+    PcapIfFlexray,
+    PcapIfPdu,
+    __PcapIfCount,
+} PcapIf;
 
 
 typedef struct NCodecTraceData {
@@ -31,7 +46,15 @@ typedef struct NCodecTraceData {
     char        identifier[NCT_ID_LEN];
     /* Filters. */
     bool        wildcard;
-    HashMap     filter;
+    uint32_t*   filter; /* Sorted frame/PDU ids. */
+    size_t      filter_count;
+    /* Binary trace (pcapng). */
+    const char* pcap_path;
+    int         pcap_if[__PcapIfCount];
+    /* Text trace, per codec so that codecs may trace from several threads
+       (i.e. PDU Network worker pool). */
+    char        log_buffer[NCT_BUFFER_LEN];
+    char        log_identifier[NCT_ID_LEN];
 } NCodecTraceData;
 
 
@@ -47,6 +70,112 @@ static const char* _get_codec_config(NCodecInstance* nc, const char* name)
 }
 
 
+static int _id_compar(const void* a, const void* b)
+{
+    uint32_t _a = *(const uint32_t*)a;
+    uint32_t _b = *(const uint32_t*)b;
+    return (_a > _b) - (_a < _b);
+}
+
+
+static bool _filter_match(NCodecTraceData* td, uint32_t id)
+{
+    if (td->wildcard) return true;
+    return bsearch(&id, td->filter, td->filter_count, sizeof(uint32_t),
+               _id_compar) != NULL;
+}
+
+
+/* PCAP Trace
+   ---------- */
+static int _pcap_if(NCodecTraceData* td, PcapIf kind, uint16_t link_type)
+{
+    if (td->pcap_if[kind] == PCAP_IF_NONE) {
+        char name[NCT_ID_LEN * 2];
+        snprintf(name, sizeof(name), "%s:%s", td->model_inst_name,
+            td->identifier);
+        int if_id = ncodec_pcap_open(td->pcap_path, link_type, name);
+        td->pcap_if[kind] = (if_id < 0) ? PCAP_IF_ERROR : if_id;
+    }
+    return td->pcap_if[kind];
+}
+
+
+static void _pcap_can(NCodecTraceData* td, uint32_t id, bool extended,
+    bool fd, const uint8_t* data, size_t len, bool rx)
+{
+    int if_id = _pcap_if(td, PcapIfCan, LINKTYPE_CAN_SOCKETCAN);
+    if (if_id < 0) return;
+
+    /* SocketCAN header, can_id is BigEndian. */
+    if (len > 64) len = 64;
+    if (extended) id |= CAN_EFF_FLAG;
+    uint8_t h[8] = { id >> 24, id >> 16, id >> 8, id, len, fd ? CANFD_FDF : 0 };
+    ncodec_pcap_write(if_id, *td->simulation_time, rx, h, sizeof(h), data, len);
+}
+
+
+static void _pcap_flexray(NCodecTraceData* td, NCodecPdu* pdu, bool rx)
+{
+    int if_id = _pcap_if(td, PcapIfFlexray, LINKTYPE_FLEXRAY);
+    if (if_id < 0) return;
+
+    /* Measurement header (FlexRay frame, channel A), error flags, and the
+       FlexRay frame header (header CRC and cycle count are not set). */
+    uint16_t slot = pdu->id & 0x7ff;
+    uint8_t  words = ((pdu->payload_len + 1) / 2) & 0x7f;
+    uint8_t  h[7] = {
+        0x01,
+        0x00,
+        (pdu->payload_len ? 0x20 : 0) | (slot >> 8),
+        slot & 0xff,
+        words << 1,
+    };
+    ncodec_pcap_write(if_id, *td->simulation_time, rx, h, sizeof(h),
+        pdu->payload, pdu->payload_len);
+}
+
+
+static void _pcap_pdu(NCodecTraceData* td, NCodecPdu* pdu, bool rx)
+{
+    switch (pdu->transport_type) {
+    case NCodecPduTransportTypeCan: {
+        NCodecPduCanFrameFormat f = pdu->transport.can_message.frame_format;
+        _pcap_can(td, pdu->id,
+            f == NCodecPduCanFrameFormatExtended ||
+                f == NCodecPduCanFrameFormatFdExtended,
+            f == NCodecPduCanFrameFormatFdBase ||
+                f == NCodecPduCanFrameFormatFdExtended,
+            pdu->payload, pdu->payload_len, rx);
+        return;
+    }
+    case NCodecPduTransportTypeFlexray:
+        /* Only LPDUs are frames, config and status are not traced. */
+        if (pdu->transport.flexray.metadata_type ==
+            NCodecPduFlexrayMetadataTypeLpdu) {
+            _pcap_flexray(td, pdu, rx);
+        }
+        return;
+    default:
+        break;
+    }
+
+    /* Native PDU header: id, swc_id, ecu_id (BigEndian), transport type. */
+    int if_id = _pcap_if(td, PcapIfPdu, LINKTYPE_USER0);
+    if (if_id < 0) return;
+    uint32_t v[3] = { pdu->id, pdu->swc_id, pdu->ecu_id };
+    uint8_t  h[16] = { [12] = pdu->transport_type };
+    for (size_t i = 0; i < ARRAY_SIZE(v); i++) {
+        h[i * 4 + 0] = v[i] >> 24;
+        h[i * 4 + 1] = v[i] >> 16;
+        h[i * 4 + 2] = v[i] >> 8;
+        h[i * 4 + 3] = v[i];
+    }
+    ncodec_pcap_write(if_id, *td->simulation_time, rx, h, sizeof(h),
+        pdu->payload, pdu->payload_len);
+}
+
+
 /* CAN Trace
    --------- */
 static void _trace_can_log(
@@ -54,8 +183,8 @@ static void _trace_can_log(
 {
     NCodecTraceData*  td = nc->private;
     NCodecCanMessage* msg = m;
-    static char       b[NCT_BUFFER_LEN];
-    static char       identifier[NCT_ID_LEN];
+    char*             b = td->log_buffer;
+    char*             identifier = td->log_identifier;
 
     /* Setup bus identifier (on first call). */
     if (strlen(td->identifier) == 0) {
@@ -65,10 +194,15 @@ static void _trace_can_log(
     }
 
     /* Filter the message. */
-    if (td->wildcard == false) {
-        char key[NCT_KEY_LEN];
-        snprintf(key, NCT_KEY_LEN, "%u", msg->frame_id);
-        if (hashmap_get(&td->filter, key) == NULL) return;
+    if (_filter_match(td, msg->frame_id) == false) return;
+    if (td->pcap_path) {
+        _pcap_can(td, msg->frame_id,
+            msg->frame_type == CAN_EXTENDED_FRAME ||
+                msg->frame_type == CAN_FD_EXTENDED_FRAME,
+            msg->frame_type == CAN_FD_BASE_FRAME ||
+                msg->frame_type == CAN_FD_EXTENDED_FRAME,
+            msg->buffer, msg->len, strcmp(direction, "RX") == 0);
+        return;
     }
 
     /* Format and write the log. */
@@ -83,23 +217,23 @@ static void _trace_can_log(
         // Short form log.
         for (uint32_t i = 0; i < msg->len; i++) {
             if (i && (i % 8 == 0)) {
-                snprintf(b + strlen(b), sizeof(b) - strlen(b), " ");
+                snprintf(b + strlen(b), NCT_BUFFER_LEN - strlen(b), " ");
             }
-            snprintf(
-                b + strlen(b), sizeof(b) - strlen(b), " %02x", msg->buffer[i]);
+            snprintf(b + strlen(b), NCT_BUFFER_LEN - strlen(b), " %02x",
+                msg->buffer[i]);
         }
     } else {
         // Long form log.
         for (uint32_t i = 0; i < msg->len; i++) {
             if (strlen(b) > NCT_BUFFER_LEN) break;
             if (i % 32 == 0) {
-                snprintf(b + strlen(b), sizeof(b) - strlen(b), "\n ");
+                snprintf(b + strlen(b), NCT_BUFFER_LEN - strlen(b), "\n ");
             }
             if (i % 8 == 0) {
-                snprintf(b + strlen(b), sizeof(b) - strlen(b), " ");
+                snprintf(b + strlen(b), NCT_BUFFER_LEN - strlen(b), " ");
             }
-            snprintf(
-                b + strlen(b), sizeof(b) - strlen(b), " %02x", msg->buffer[i]);
+            snprintf(b + strlen(b), NCT_BUFFER_LEN - strlen(b), " %02x",
+                msg->buffer[i]);
         }
     }
     log_notice("(%s) %.6f [%s] %s %02x %d %d :%s", td->model_inst_name,
@@ -267,8 +401,8 @@ static void _trace_pdu_log(
 {
     NCodecTraceData* td = nc->private;
     NCodecPdu*       pdu = m;
-    static char      b[NCT_BUFFER_LEN];
-    static char      identifier[NCT_ID_LEN];
+    char*            b = td->log_buffer;
+    char*            identifier = td->log_identifier;
 
     /* Setup bus identifier (on first call). */
     if (strlen(td->identifier) == 0) {
@@ -277,10 +411,10 @@ static void _trace_pdu_log(
     }
 
     /* Filter the message. */
-    if (td->wildcard == false) {
-        char key[NCT_KEY_LEN];
-        snprintf(key, NCT_KEY_LEN, "%u", pdu->id);
-        if (hashmap_get(&td->filter, key) == NULL) return;
+    if (_filter_match(td, pdu->id) == false) return;
+    if (td->pcap_path) {
+        _pcap_pdu(td, pdu, strcmp(direction, "RX") == 0);
+        return;
     }
 
     /* Format and write the log. */
@@ -294,23 +428,23 @@ static void _trace_pdu_log(
         // Short form log.
         for (uint32_t i = 0; i < pdu->payload_len; i++) {
             if (i && (i % 8 == 0)) {
-                snprintf(b + strlen(b), sizeof(b) - strlen(b), " ");
+                snprintf(b + strlen(b), NCT_BUFFER_LEN - strlen(b), " ");
             }
-            snprintf(
-                b + strlen(b), sizeof(b) - strlen(b), " %02x", pdu->payload[i]);
+            snprintf(b + strlen(b), NCT_BUFFER_LEN - strlen(b), " %02x",
+                pdu->payload[i]);
         }
     } else {
         // Long form log.
         for (uint32_t i = 0; i < pdu->payload_len; i++) {
             if (strlen(b) > NCT_BUFFER_LEN) break;
             if (i % 32 == 0) {
-                snprintf(b + strlen(b), sizeof(b) - strlen(b), "\n ");
+                snprintf(b + strlen(b), NCT_BUFFER_LEN - strlen(b), "\n ");
             }
             if (i % 8 == 0) {
-                snprintf(b + strlen(b), sizeof(b) - strlen(b), " ");
+                snprintf(b + strlen(b), NCT_BUFFER_LEN - strlen(b), " ");
             }
-            snprintf(
-                b + strlen(b), sizeof(b) - strlen(b), " %02x", pdu->payload[i]);
+            snprintf(b + strlen(b), NCT_BUFFER_LEN - strlen(b), " %02x",
+                pdu->payload[i]);
         }
     }
     log_notice("(%s) %.6f [%s] %s %02x %d :%s", td->model_inst_name,
@@ -520,7 +654,11 @@ DLL_PRIVATE void ncodec_trace_configure(
 
     td->model_inst_name = mi->name;
     td->simulation_time = &am->model_time;
-    hashmap_init(&td->filter);
+    td->pcap_path = getenv("NCODEC_TRACE_PCAP");
+    for (size_t i = 0; i < __PcapIfCount; i++) {
+        td->pcap_if[i] = PCAP_IF_NONE;
+    }
+    if (td->pcap_path) log_notice("    pcap: %s", td->pcap_path);
     if (strcmp(filter, "*") == 0) {
         td->wildcard = true;
         log_notice("    <wildcard> (all frames)");
@@ -531,14 +669,15 @@ DLL_PRIVATE void ncodec_trace_configure(
         while (_idptr) {
             int64_t _id = strtol(_idptr, NULL, 0);
             if (_id > 0) {
-                char key[NCT_KEY_LEN];
-                snprintf(key, NCT_KEY_LEN, "%u", (uint32_t)_id);
-                hashmap_set_long(&td->filter, key, true);
+                td->filter = realloc(td->filter,
+                    (td->filter_count + 1) * sizeof(uint32_t));
+                td->filter[td->filter_count++] = (uint32_t)_id;
                 log_notice("    %02x", _id);
             }
             _idptr = strtok_r(NULL, ",", &_saveptr);
         }
         free(_filter);
+        qsort(td->filter, td->filter_count, sizeof(uint32_t), _id_compar);
     }
 
     /* Install the trace. */
@@ -558,7 +697,10 @@ DLL_PRIVATE void ncodec_trace_destroy(NCodecInstance* nc)
 {
     if (nc->private) {
         NCodecTraceData* td = nc->private;
-        hashmap_destroy(&td->filter);
+        for (size_t i = 0; i < __PcapIfCount; i++) {
+            if (td->pcap_if[i] >= 0) ncodec_pcap_close();
+        }
+        free(td->filter);
         free(td);
         nc->private = NULL;
     }
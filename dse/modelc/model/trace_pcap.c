@@ -0,0 +1,381 @@
+// Copyright 2026 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <dse/logger.h>
+#include <dse/platform.h>
+#include <dse/modelc/controller/model_private.h>
+
+
+/*
+NCodec PCAPNG Trace Writer
+==========================
+
+A process wide writer of pcapng capture files. Trace functions (called from
+the NCodec trace hooks) format each frame as an Enhanced Packet Block into
+a memory buffer, and a background thread writes the buffered blocks to the
+capture file. Each traced NCodec (and link type) is represented by its own
+Interface Description Block.
+
+When the writer falls behind (the buffer is full) frames are dropped, and the
+number of dropped frames (including failed writes to the capture file) is
+logged when the capture file is closed.
+*/
+
+
+#define PCAPNG_BLOCK_SHB  0x0A0D0D0A
+#define PCAPNG_BLOCK_IDB  0x00000001
+#define PCAPNG_BLOCK_EPB  0x00000006
+#define PCAPNG_BOM        0x1A2B3C4D
+#define PCAPNG_OPT_END    0
+#define PCAPNG_OPT_NAME   2 /* if_name */
+#define PCAPNG_OPT_FLAGS  2 /* epb_flags */
+#define PCAPNG_BUFFER_MAX (16 * 1024 * 1024)
+#define PAD4(x)           (((x) + 3) & ~(size_t)3)
+
+
+typedef struct PcapBuffer {
+    uint8_t* data;
+    size_t   len;
+    size_t   size;
+} PcapBuffer;
+
+
+typedef struct PcapWriter {
+    FILE*           file;
+    unsigned int    refcount;
+    uint32_t        if_count;
+    size_t          dropped; /* Frames dropped, and failed writes. */
+    /* Writer thread. */
+    pthread_t       thread;
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    bool            running;
+    PcapBuffer      front; /* Appended by trace functions (protected). */
+    PcapBuffer      back;  /* Written by the writer thread. */
+} PcapWriter;
+
+
+static PcapWriter*     __pcap = NULL;
+static pthread_mutex_t __pcap_lock = PTHREAD_MUTEX_INITIALIZER;
+
+
+/* Reserve space in the front buffer, call with lock held. */
+static uint8_t* _reserve(PcapWriter* w, size_t len)
+{
+    if (w->front.len + len > w->front.size) {
+        size_t size = w->front.size ? w->front.size : 64 * 1024;
+        while (size < w->front.len + len)
+            size *= 2;
+        if (size > PCAPNG_BUFFER_MAX) return NULL;
+        uint8_t* data = realloc(w->front.data, size);
+        if (data == NULL) return NULL;
+        w->front.data = data;
+        w->front.size = size;
+    }
+    uint8_t* p = w->front.data + w->front.len;
+    w->front.len += len;
+    return p;
+}
+
+
+static uint8_t* _put32(uint8_t* p, uint32_t v)
+{
+    memcpy(p, &v, sizeof(v));
+    return p + sizeof(v);
+}
+
+
+static uint8_t* _put16(uint8_t* p, uint16_t v)
+{
+    memcpy(p, &v, sizeof(v));
+    return p + sizeof(v);
+}
+
+
+static uint8_t* _put_data(uint8_t* p, const void* data, size_t len)
+{
+    if (len) memcpy(p, data, len);
+    memset(p + len, 0, PAD4(len) - len);
+    return p + PAD4(len);
+}
+
+
+static void* _writer(void* arg)
+{
+    PcapWriter* w = arg;
+
+    pthread_mutex_lock(&w->lock);
+    while (1) {
+        while (w->running && w->front.len == 0) {
+            pthread_cond_wait(&w->cond, &w->lock);
+        }
+        if (w->front.len == 0) break;
+        /* Swap the buffers, then write without the lock. */
+        PcapBuffer b = w->back;
+        w->back = w->front;
+        w->front = b;
+        pthread_mutex_unlock(&w->lock);
+        size_t len = fwrite(w->back.data, 1, w->back.len, w->file);
+        bool   failed = (len != w->back.len);
+        w->back.len = 0;
+        pthread_mutex_lock(&w->lock);
+        if (failed) w->dropped++;
+    }
+    pthread_mutex_unlock(&w->lock);
+    return NULL;
+}
+
+
+static void _writer_free(PcapWriter* w)
+{
+    fclose(w->file);
+    pthread_cond_destroy(&w->cond);
+    pthread_mutex_destroy(&w->lock);
+    free(w->front.data);
+    free(w->back.data);
+    free(w);
+}
+
+
+/* Stop the writer thread (all buffered frames are written), then close the
+capture file and release the writer. */
+static void _writer_close(PcapWriter* w)
+{
+    pthread_mutex_lock(&w->lock);
+    w->running = false;
+    pthread_cond_signal(&w->cond);
+    pthread_mutex_unlock(&w->lock);
+    pthread_join(w->thread, NULL);
+    if (w->dropped) {
+        log_notice("NCodec PCAP: %u frames dropped (or not written)",
+            (unsigned)w->dropped);
+    }
+    _writer_free(w);
+}
+
+
+static PcapWriter* _writer_open(const char* path)
+{
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {
+        log_error("NCodec PCAP: unable to open file (%s)", path);
+        return NULL;
+    }
+    PcapWriter* w = calloc(1, sizeof(PcapWriter));
+    if (w == NULL) {
+        fclose(file);
+        return NULL;
+    }
+    w->file = file;
+    pthread_mutex_init(&w->lock, NULL);
+    pthread_cond_init(&w->cond, NULL);
+
+    /* Section Header Block. */
+    uint8_t* p = _reserve(w, 28);
+    if (p == NULL) {
+        _writer_free(w);
+        return NULL;
+    }
+    p = _put32(p, PCAPNG_BLOCK_SHB);
+    p = _put32(p, 28);
+    p = _put32(p, PCAPNG_BOM);
+    p = _put16(p, 1);
+    p = _put16(p, 0);
+    p = _put32(p, UINT32_MAX); /* Section length (-1, not specified). */
+    p = _put32(p, UINT32_MAX);
+    p = _put32(p, 28);
+
+    w->running = true;
+    if (pthread_create(&w->thread, NULL, _writer, w)) {
+        log_error("NCodec PCAP: unable to start writer thread");
+        _writer_free(w);
+        return NULL;
+    }
+    log_notice("NCodec PCAP: %s", path);
+    return w;
+}
+
+
+/**
+ncodec_pcap_open
+================
+
+Open (or reference) the process wide capture file, and add an interface.
+
+Parameters
+----------
+path (const char*)
+: Path of the capture file, only used by the first call.
+
+link_type (uint16_t)
+: The pcap link type of the interface (e.g. 227 for SocketCAN).
+
+name (const char*)
+: Name of the interface.
+
+Returns
+-------
+int
+: The interface id, used with `ncodec_pcap_write()`.
+
+-1
+: The capture file could not be opened.
+*/
+DLL_PRIVATE int ncodec_pcap_open(
+    const char* path, uint16_t link_type, const char* name)
+{
+    pthread_mutex_lock(&__pcap_lock);
+    if (__pcap == NULL) __pcap = _writer_open(path);
+    PcapWriter* w = __pcap;
+    if (w == NULL) {
+        pthread_mutex_unlock(&__pcap_lock);
+        return -1;
+    }
+
+    /* Interface Description Block. The reference is taken first, so that
+    the writer is released (if otherwise unused) when the block can not be
+    reserved. */
+    size_t name_len = name ? strlen(name) : 0;
+    size_t len = 20 + (name_len ? 4 + PAD4(name_len) : 0) + 4;
+    pthread_mutex_lock(&w->lock);
+    w->refcount++;
+    uint8_t* p = _reserve(w, len);
+    if (p == NULL) {
+        bool release = (--w->refcount == 0);
+        pthread_mutex_unlock(&w->lock);
+        if (release) __pcap = NULL;
+        pthread_mutex_unlock(&__pcap_lock);
+        if (release) _writer_close(w);
+        return -1;
+    }
+    p = _put32(p, PCAPNG_BLOCK_IDB);
+    p = _put32(p, len);
+    p = _put16(p, link_type);
+    p = _put16(p, 0);
+    p = _put32(p, 0); /* Snap length, unlimited. */
+    if (name_len) {
+        p = _put16(p, PCAPNG_OPT_NAME);
+        p = _put16(p, name_len);
+        p = _put_data(p, name, name_len);
+    }
+    p = _put32(p, PCAPNG_OPT_END);
+    p = _put32(p, len);
+    int if_id = w->if_count++;
+    pthread_cond_signal(&w->cond);
+    pthread_mutex_unlock(&w->lock);
+
+    pthread_mutex_unlock(&__pcap_lock);
+    return if_id;
+}
+
+
+/**
+ncodec_pcap_write
+=================
+
+Write a frame (as an Enhanced Packet Block) to the capture file. The frame
+is buffered and written by the writer thread.
+
+Parameters
+----------
+if_id (int)
+: The interface id, from `ncodec_pcap_open()`.
+
+timestamp (double)
+: Timestamp of the frame (simulation time).
+
+rx (bool)
+: The frame was received (inbound), otherwise transmitted (outbound).
+
+header (const uint8_t*)
+: Link type header of the frame.
+
+header_len (size_t)
+: Length of the header.
+
+data (const uint8_t*)
+: Frame data (payload).
+
+data_len (size_t)
+: Length of the frame data.
+*/
+DLL_PRIVATE void ncodec_pcap_write(int if_id, double timestamp, bool rx,
+    const uint8_t* header, size_t header_len, const uint8_t* data,
+    size_t data_len)
+{
+    if (if_id < 0) return;
+
+    uint64_t ts = (uint64_t)(timestamp * 1e6); /* Microseconds. */
+    size_t   cap_len = header_len + data_len;
+    size_t   len = 28 + PAD4(cap_len) + 8 + 4 + 4;
+
+    /* Hold the writer lock before releasing the process lock, the writer
+    is not released (by ncodec_pcap_close()) while a frame is appended. */
+    pthread_mutex_lock(&__pcap_lock);
+    PcapWriter* w = __pcap;
+    if (w == NULL) {
+        pthread_mutex_unlock(&__pcap_lock);
+        return;
+    }
+    pthread_mutex_lock(&w->lock);
+    pthread_mutex_unlock(&__pcap_lock);
+    uint8_t* p = _reserve(w, len);
+    if (p == NULL) {
+        w->dropped++;
+        pthread_mutex_unlock(&w->lock);
+        return;
+    }
+    p = _put32(p, PCAPNG_BLOCK_EPB);
+    p = _put32(p, len);
+    p = _put32(p, if_id);
+    p = _put32(p, ts >> 32);
+    p = _put32(p, ts & UINT32_MAX);
+    p = _put32(p, cap_len);
+    p = _put32(p, cap_len);
+    if (header_len) memcpy(p, header, header_len);
+    if (data_len) memcpy(p + header_len, data, data_len);
+    memset(p + cap_len, 0, PAD4(cap_len) - cap_len);
+    p += PAD4(cap_len);
+    p = _put16(p, PCAPNG_OPT_FLAGS);
+    p = _put16(p, 4);
+    p = _put32(p, rx ? 0x1 : 0x2); /* Direction, inbound or outbound. */
+    p = _put32(p, PCAPNG_OPT_END);
+    p = _put32(p, len);
+    pthread_cond_signal(&w->cond);
+    pthread_mutex_unlock(&w->lock);
+}
+
+
+/**
+ncodec_pcap_close
+=================
+
+Release a reference to the capture file. The last reference stops the writer
+thread (all buffered frames are written) and closes the capture file.
+*/
+DLL_PRIVATE void ncodec_pcap_close(void)
+{
+    pthread_mutex_lock(&__pcap_lock);
+    PcapWriter* w = __pcap;
+    if (w == NULL) {
+        pthread_mutex_unlock(&__pcap_lock);
+        return;
+    }
+    pthread_mutex_lock(&w->lock);
+    bool release = (w->refcount > 0 && --w->refcount == 0);
+    pthread_mutex_unlock(&w->lock);
+    if (release == false) {
+        pthread_mutex_unlock(&__pcap_lock);
+        return;
+    }
+    __pcap = NULL;
+    pthread_mutex_unlock(&__pcap_lock);
+    _writer_close(w);
+}
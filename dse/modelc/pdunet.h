@@ -39,15 +39,30 @@ typedef struct PduNetworkDesc PduNetworkDesc;
 typedef int                   lua_func_t;
 
 
+typedef enum {
+    PduByteOrderLittleEndian = 0, /* "LittleEndian" (Intel), default. */
+    PduByteOrderBigEndian = 1,    /* "BigEndian" (Motorola). */
+    __PduByteOrderCount = 2,
+} PduByteOrder;
+
+
 typedef struct PduSignalItem {
-    const char* name;
+    const char*  name;
     /* Signal properties. */
-    uint16_t    start_bit;
-    uint16_t    length_bits;
-    double      factor; /* Prohibited value 0. */
-    double      offset;
-    double      min; /* Optional, set NaN. */
-    double      max; /* Optional, set Nan. */
+    uint16_t     start_bit; /* BigEndian: position of the MSB. */
+    uint16_t     length_bits;
+    PduByteOrder byte_order;
+    bool         is_signed; /* Two's complement raw value. */
+    double       factor;    /* Prohibited value 0. */
+    double       offset;
+    double       min; /* Optional, set NaN. */
+    double       max; /* Optional, set Nan. */
+    /* Multiplexing. */
+    struct {
+        bool     selector; /* Selects the active multiplexed Signals. */
+        bool     muxed;    /* Multiplexed, active when selector == value. */
+        uint32_t value;
+    } mux;
     /* Functions. */
     struct {
         const char* encode;
@@ -80,6 +95,14 @@ typedef enum {
     __HeaderFormatCount = 4,
 } HeaderFormat;
 
+typedef enum {
+    PduE2eProfileNone = 0,
+    PduE2eProfileCrc8 = 1,  /* "CRC8", SAE-J1850 (0x1D). */
+    PduE2eProfileCrc16 = 2, /* "CRC16", CCITT (0x1021). */
+    PduE2eProfileCrc32 = 3, /* "CRC32", P4 (0xF4ACFB13). */
+    __PduE2eProfileCount = 4,
+} PduE2eProfile;
+
 
 typedef struct PduItem {
     const char*  name;
@@ -114,6 +137,23 @@ typedef struct PduItem {
         lua_func_t  tx_ref;
         lua_func_t  rx_ref;
     } lua;
+    /* E2E Protection (native, applied before the Tx function and after
+    the Rx function). */
+    struct {
+        PduE2eProfile profile;
+        uint16_t      data_id;    /* Mixed into the CRC. */
+        uint16_t      crc_offset; /* Byte offset of the CRC (BigEndian). */
+        struct {
+            uint16_t offset; /* Byte offset of the counter. */
+            uint8_t  bits;   /* 0 (no counter), 4 (low nibble) or 8. */
+        } counter;
+    } e2e;
+    /* Routing (Tx), the payload is routed from an Rx PDU of another
+    PDU Network. */
+    struct {
+        const char* network; /* Network name (metadata/name). */
+        const char* pdu;     /* Rx PDU name. */
+    } route;
     /* Metadata. */
     struct {
         void* config;
@@ -123,21 +163,36 @@ typedef struct PduItem {
 } PduItem;
 
 
+typedef struct PduMuxGroup {
+    uint32_t value;  /* Selector value. */
+    size_t   offset; /* Offset into matrix.signal */
+    size_t   count;
+} PduMuxGroup;
+
+
 typedef struct PduObject {  // FIXME: internal type ??
     PduItem* pdu;
     bool     needs_tx;
     bool     update_signals;
-    uint32_t checksum; /* Detects changed payload. */
+    uint32_t checksum; /* Payload at last Tx (0 forces Tx). */
+    bool     changed;  /* Payload changed by pack, since last Tx. */
     struct {
         size_t pdu_idx;
         struct {
             size_t offset; /* Offset into matrix.signal */
             size_t count;
         } range;
+        struct PduRange* pdu_range; /* The PduRange containing this PDU. */
     } matrix;
+    struct {
+        size_t selector; /* Offset into matrix.signal */
+        Vector group;    /* PduMuxGroup, sorted by value. */
+        size_t active;   /* Index of the active group (SIZE_MAX = none). */
+    } mux;
     struct {
         HeaderFormat header;   /* When set this is a Container-PDU (L-PDU). */
         Vector       pdu_list; /* Sorted (by priority) list of I-PDUs*/
+        Vector       id_index; /* Index (by id) into pdu_list. */
     } container;
     struct {
         uint32_t interval; /* Normalised value, factor of step_size. */
@@ -151,7 +206,18 @@ typedef struct PduObject {  // FIXME: internal type ??
         /* Called on PDU tx/rx. */
         lua_func_t tx_ref;
         lua_func_t rx_ref;
+        /* Lua may modify the payload, detect changes by checksum. */
+        bool       modifies_payload;
     } lua;
+    struct {
+        uint8_t  counter; /* Tx: next counter, Rx: last counter. */
+        bool     counter_valid; /* Rx: a counter was received. */
+        uint32_t errors;        /* Rx: PDUs rejected by E2E check. */
+    } e2e;
+    struct {
+        struct PduObject* source;   /* Tx: the routed (Rx) PDU. */
+        uint32_t          rx_count; /* Rx: accepted, Tx: source at route. */
+    } route;
     struct {
         /* NCodec Objects. */
         // NCodecPdu pdu;
@@ -171,6 +237,8 @@ typedef struct PduRange {
     size_t       offset;
     size_t       length;
     Vector       pdu_list; /* o.matrix.pdu_idx / size_t */
+    Vector       scalar_list; /* size_t, non-linear signals (range index). */
+    Vector       mux_list; /* o.matrix.pdu_idx / size_t, multiplexed PDUs. */
     /* Default range criteria is direction.*/
     PduDirection dir;
     /* Complex sort may produce specific range criteria. */
@@ -185,6 +253,8 @@ typedef struct PduTransformMatrix {  // FIXME: internal type ??
     Vector payload; /* uint8_t*, allocated vector of payloads. */
     /* Range objects, resultant from sorting. */
     Vector range;
+    /* Index (by id) of Rx PDUs, excluding Container I-PDUs. */
+    Vector rx_index;
 
     /* Signal matrix, sorted by func, default is pdu.tx/rx then pdu.id. */
     struct {
@@ -196,6 +266,8 @@ typedef struct PduTransformMatrix {  // FIXME: internal type ??
         Vector name; /* const char* */
         /* Schedule. */
         Vector skip; /* bool, 0=update (default, 1 = skip matrix row) */
+        /* Multiplexing. */
+        Vector inactive; /* uint8_t, 1 = multiplexed, not selected. */
         /* Linear Transform. */
         Vector phys;   /* double, signal value (physical) */
         Vector raw;    /* uint64_t, signal value (raw) */
@@ -203,12 +275,20 @@ typedef struct PduTransformMatrix {  // FIXME: internal type ??
         Vector offset; /* double */
         Vector min;    /* double, clamps value */
         Vector max;    /* double, clamps value */
+        Vector linear; /* uint8_t, no Lua, valid factor/offset, raw int64 */
         /* Complex (Lua) Transform. */
         Vector encode; /* Lua function handle (lua_func_t) */
         Vector decode; /* Lua function handle (lua_func_t) */
         /* Encoding. */
         Vector start_bit;   /* uint16_t */
         Vector length_bits; /* uint16_t */
+        Vector is_signed;   /* bool */
+        /* Pack/Unpack (precalculated from encoding). */
+        Vector byte_order;  /* uint8_t, PduByteOrder */
+        Vector byte_offset; /* uint16_t, first byte of payload word */
+        Vector byte_count;  /* uint8_t, bytes in payload word (max 9) */
+        Vector shift;       /* uint8_t, position of LSB in payload word */
+        Vector mask;        /* uint64_t, mask of value (length_bits) */
     } signal;
 } PduTransformMatrix;
 
@@ -231,6 +311,9 @@ typedef struct PduNetworkNCodecVTable {
     struct {
         uint8_t  cycle;
         uint32_t cycle_time; /* Normalised (to step_size). */
+        /* Direct tables (to matrix.pdu index) for Tx/Rx. */
+        Vector   frame_index; /* size_t, indexed by frame_config_index. */
+        Vector   lpdu_list;   /* size_t, L-PDUs in matrix order. */
     } flexray;
 } PduNetworkNCodecVTable;
 
@@ -259,24 +342,54 @@ typedef struct PduNetworkDesc {
         double   step_size;
         double   step_size_epsilon;
         double   epoch_offset;
+        /* Tx schedule (event driven). */
+        struct {
+            bool     valid;
+            int32_t  epoch_offset;    /* Normalised, basis of the queue. */
+            uint32_t simulation_time; /* Normalised, previous schedule. */
+            Vector   queue;     /* PduScheduleItem, min-heap on due time. */
+            Vector   on_change; /* size_t, matrix.pdu (no interval). */
+            Vector   active;    /* size_t, matrix.pdu (skip was cleared). */
+            /* Idle step detection. */
+            bool     pending;    /* Tx required (e.g. L-PDU status reset). */
+            bool     every_step; /* On-change PDUs with Lua encode. */
+        } tx;
     } schedule;
 
     /* Functions. */
     struct {
         const char* global;
+        bool        installed; /* Lua functions installed (shared state). */
     } lua;
 
     /* PDUs (and Signals) parsed from Network YAML. */
     Vector pdus; /* PduItem */
 
+    /* Network Cache (annotation "cache"). */
+    struct {
+        void* data; /* Loaded cache, backing store of PDU strings. */
+    } cache;
+
     /* Transformed matrix (of PduObject objects and matrix vectors). */
     PduTransformMatrix matrix;
 
+    /* Routing (linked by pdunet_route_link()). */
+    struct {
+        Vector list; /* size_t, matrix.pdu (routed Tx PDUs). */
+    } route;
+
     /* Marshal Signal Map (to SignalVector, NTL). */
     struct {
         MarshalSignalMap* in;  /* Bus Rx. */
         MarshalSignalMap* out; /* Bus Tx. */
+        /* Copy program, built from the MSM (used at runtime). */
+        double*           scalar;  /* SignalVector scalars. */
+        Vector            run_in;  /* PduMarshalRun, Bus Rx. */
+        Vector            run_out; /* PduMarshalRun, Bus Tx. */
     } msm;
+
+    /* Range of the current pdunet_tx()/pdunet_rx() call (NULL = all). */
+    PduRange* range;
 } PduNetworkDesc;
 
 
@@ -299,6 +412,8 @@ DLL_PUBLIC void pdunet_tx(PduNetworkDesc* net, PduRange* range,
 DLL_PUBLIC void pdunet_rx(PduNetworkDesc* net, PduRange* range,
     PduNetworkVisitFunc visit, void* data);
 
+DLL_PUBLIC int pdunet_route_link(PduNetworkDesc* net, PduNetworkDesc* source);
+
 DLL_PUBLIC void pdunet_destroy(PduNetworkDesc* net);
 
 DLL_PUBLIC void pdunet_visit_clear_update_flag(
@@ -315,5 +430,7 @@ DLL_PUBLIC void pdunet_visit_needs_tx(
 DLL_PUBLIC void pdunet_call_tx_func(PduNetworkDesc* net, PduObject* pdu);
 DLL_PUBLIC int  pdunet_call_rx_func(
      PduNetworkDesc* net, PduObject* pdu, uint8_t* payload, size_t payload_len);
+DLL_PUBLIC int  pdunet_call_signal_range_func(
+     PduNetworkDesc* net, PduObject* pdu, lua_func_t func_ref);
 
 #endif  // DSE_MODELC_PDUNET_H_
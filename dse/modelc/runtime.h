@@ -152,6 +152,9 @@ DLL_PUBLIC void          model_sv_destroy(SignalVector* sv);
 /* ncodec.c - Stream Interface (for NCodec). */
 DLL_PRIVATE void* model_sv_stream_create(SignalVector* sv, uint32_t idx);
 DLL_PRIVATE void  model_sv_stream_destroy(void* stream);
+DLL_PUBLIC int    model_sv_stream_reserve(
+    void* nc, size_t len, uint8_t** data);
+DLL_PUBLIC int    model_sv_stream_commit(void* nc, size_t len);
 
 
 /* model.c - Model Interface. */
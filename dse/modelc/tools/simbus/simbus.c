@@ -6,6 +6,7 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <assert.h>
+#include <errno.h>
 #include <unistd.h>
 #include <dse/clib/util/yaml.h>
 #include <dse/modelc/adapter/adapter.h>
@@ -78,6 +79,18 @@ int main(int argc, char** argv)
     YamlNode* model_node;
     model_node = dse_yaml_find_node_in_seq_in_doclist(
         args.yaml_doc_list, "Stack", "spec/models", "name", args.name);
+
+    /* CPU affinity of the SimBus loop (and the channel allocations). */
+    YamlNode* a_node = dse_yaml_find_node(model_node, "annotations");
+    if (a_node) {
+        int rc = adapter_set_cpu_affinity(
+            dse_yaml_get_scalar(a_node, "cpu_affinity"));
+        if (rc && rc != -ENOSYS) {
+            errno = -rc;
+            log_fatal("Could not set CPU affinity!");
+        }
+    }
+
     YamlNode* ch_seq_node;
     ch_seq_node = dse_yaml_find_node(model_node, "channels");
     if (ch_seq_node) {
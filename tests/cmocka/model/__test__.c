@@ -22,6 +22,9 @@ extern int run_ncodec_can_tests(void);
 extern int run_ncodec_pdu_tests(void);
 extern int run_stack_tests(void);
 extern int run_model_pdu_tests(void);
+extern int run_pacing_tests(void);
+extern int run_affinity_tests(void);
+extern int run_trace_pcap_tests(void);
 
 
 int main()
@@ -36,5 +39,8 @@ int main()
     rc |= run_ncodec_pdu_tests();
     rc |= run_stack_tests();
     rc |= run_model_pdu_tests();
+    rc |= run_pacing_tests();
+    rc |= run_affinity_tests();
+    rc |= run_trace_pcap_tests();
     return rc;
 }
@@ -0,0 +1,127 @@
+// Copyright 2026 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <dse/testing.h>
+#include <dse/modelc/adapter/adapter.h>
+
+
+#define UNUSED(x)     ((void)x)
+#define ARRAY_SIZE(x) (sizeof(x) / sizeof(x[0]))
+#define CPU_COUNT_    16
+
+
+static size_t _cpu_count(bool* cpu)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < CPU_COUNT_; i++) {
+        if (cpu[i]) count++;
+    }
+    return count;
+}
+
+
+void test_affinity__cpu_list(void** state)
+{
+    UNUSED(state);
+
+    bool cpu[CPU_COUNT_];
+
+    /* Single CPU. */
+    assert_int_equal(adapter_parse_cpu_list("3", cpu, CPU_COUNT_), 0);
+    assert_int_equal(_cpu_count(cpu), 1);
+    assert_true(cpu[3]);
+
+    /* List. */
+    assert_int_equal(adapter_parse_cpu_list("1,4, 7", cpu, CPU_COUNT_), 0);
+    assert_int_equal(_cpu_count(cpu), 3);
+    assert_true(cpu[1]);
+    assert_true(cpu[4]);
+    assert_true(cpu[7]);
+
+    /* Ranges. */
+    assert_int_equal(
+        adapter_parse_cpu_list("0-3,8,10-11", cpu, CPU_COUNT_), 0);
+    assert_int_equal(_cpu_count(cpu), 7);
+    for (size_t i = 0; i <= 3; i++) {
+        assert_true(cpu[i]);
+    }
+    assert_true(cpu[8]);
+    assert_true(cpu[10]);
+    assert_true(cpu[11]);
+
+    /* Single CPU range, overlapping ranges, last CPU. */
+    assert_int_equal(adapter_parse_cpu_list("5-5,2-6,15", cpu, CPU_COUNT_), 0);
+    assert_int_equal(_cpu_count(cpu), 6);
+    assert_false(cpu[1]);
+    assert_false(cpu[7]);
+    assert_true(cpu[15]);
+}
+
+
+void test_affinity__cpu_list_invalid(void** state)
+{
+    UNUSED(state);
+
+    bool cpu[CPU_COUNT_];
+
+    /* Empty input. */
+    assert_int_equal(adapter_parse_cpu_list(NULL, cpu, CPU_COUNT_), -EINVAL);
+    assert_int_equal(adapter_parse_cpu_list("", cpu, CPU_COUNT_), -EINVAL);
+    assert_int_equal(adapter_parse_cpu_list(" , ", cpu, CPU_COUNT_), -EINVAL);
+
+    /* Invalid tokens. */
+    const char* invalid[] = {
+        "a",
+        "1a",
+        "0-3x",
+        "-1",
+        "1-",
+        "1--3",
+        "3-1",
+        "0-+3",
+        "1;2",
+    };
+    for (size_t i = 0; i < ARRAY_SIZE(invalid); i++) {
+        assert_int_equal(
+            adapter_parse_cpu_list(invalid[i], cpu, CPU_COUNT_), -EINVAL);
+    }
+
+    /* Out of range CPUs. */
+    assert_int_equal(adapter_parse_cpu_list("16", cpu, CPU_COUNT_), -ERANGE);
+    assert_int_equal(
+        adapter_parse_cpu_list("0,14-16", cpu, CPU_COUNT_), -ERANGE);
+    assert_int_equal(adapter_parse_cpu_list("99999999999999999999", cpu,
+                         CPU_COUNT_),
+        -ERANGE);
+}
+
+
+void test_affinity__set_empty(void** state)
+{
+    UNUSED(state);
+
+    /* No CPU list, affinity is not changed. */
+    assert_int_equal(adapter_set_cpu_affinity(NULL), 0);
+    assert_int_equal(adapter_set_cpu_affinity(""), 0);
+
+#if defined(__linux__)
+    /* Invalid CPU list, affinity is not changed. */
+    assert_int_equal(adapter_set_cpu_affinity("0-x"), -EINVAL);
+#endif
+}
+
+
+int run_affinity_tests(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_affinity__cpu_list),
+        cmocka_unit_test(test_affinity__cpu_list_invalid),
+        cmocka_unit_test(test_affinity__set_empty),
+    };
+
+    return cmocka_run_group_tests_name("AFFINITY", tests, NULL, NULL);
+}
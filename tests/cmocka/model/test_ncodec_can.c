@@ -8,6 +8,7 @@
 #include <dse/clib/util/yaml.h>
 #include <dse/modelc/model.h>
 #include <dse/modelc/runtime.h>
+#include <dse/modelc/controller/model_private.h>
 #include <dse/ncodec/codec.h>
 #include <dse/ncodec/interface/frame.h>
 
@@ -107,7 +108,8 @@ void test_ncodec_can__ncodec_open(void** state)
         sv++;
     }
 
-    /* Check the ncodec objects. */
+    /* Check the ncodec objects (created on first use). */
+    assert_null(sv->ncodec[2]);
     assert_null(signal_codec(sv, 0));
     assert_null(signal_codec(sv, 1));
     assert_non_null(signal_codec(sv, 2));
@@ -236,6 +238,8 @@ void test_ncodec_can__truncate(void** state)
     assert_non_null(signal_codec(sv, 2));
     assert_non_null(sv->ncodec[2]);
     assert_ptr_equal(signal_codec(sv, 2), sv->ncodec[2]);
+    assert_non_null(sv->ncodec_dirty);
+    assert_false(sv->ncodec_dirty[2]);
 
     /* Use the codec object with the ncodec library. */
     const char*     greeting = "Hello World";
@@ -251,6 +255,7 @@ void test_ncodec_can__truncate(void** state)
     assert_int_equal(len, 0x66);
     assert_int_equal(len, sv->length[2]);
     assert_int_equal(0x66, _nc->stream->tell(nc));
+    assert_true(sv->ncodec_dirty[2]);
 
     /* Truncate the NCodec, and check underlying stream/sv. */
     uint32_t _bs = sv->buffer_size[2];
@@ -262,6 +267,55 @@ void test_ncodec_can__truncate(void** state)
     assert_ptr_equal(_bin, sv->binary[2]);
     /* Check  stream properties. */
     assert_int_equal(0, _nc->stream->tell(nc));
+    assert_false(sv->ncodec_dirty[2]);
+}
+
+
+void test_ncodec_can__first_use(void** state)
+{
+    ModelCMock* mock = *state;
+
+    /* Use the "binary" signal vector. */
+    SignalVector* sv = mock->mi->model_desc->sv;
+    while (sv && sv->name) {
+        if (strcmp(sv->name, "binary") == 0) break;
+        /* Next signal vector. */
+        sv++;
+    }
+    assert_non_null(sv->name);
+
+    /* NCodec objects are created on first use. */
+    uint8_t* failed = (uint8_t*)&sv->ncodec[sv->count];
+    for (uint32_t i = 0; i < sv->count; i++) {
+        assert_null(sv->ncodec[i]);
+        assert_int_equal(failed[i], 0);
+    }
+
+    /* Failed creation is recorded, and not attempted again. */
+    assert_null(signal_codec(sv, 1));
+    assert_int_equal(failed[1], 1);
+    assert_null(signal_codec(sv, 1));
+    assert_int_equal(failed[1], 1);
+    assert_null(sv->ncodec[1]);
+
+    /* SignalVector without dirty flags (e.g. a stub SignalVector). */
+    bool* dirty = sv->ncodec_dirty;
+    sv->ncodec_dirty = NULL;
+    NCODEC* nc = signal_codec(sv, 2);
+    assert_non_null(nc);
+    const char* greeting = "Hello World";
+    int         rc = ncodec_write(nc, &(struct NCodecCanMessage){
+                                    .frame_id = 42,
+                                    .buffer = (uint8_t*)greeting,
+                                    .len = strlen(greeting) });
+    assert_int_equal(rc, strlen(greeting));
+    ncodec_flush(nc);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    ncodec_truncate(nc);
+    assert_int_equal(0, sv->length[2]);
+    sv->ncodec_dirty = dirty;
+    assert_false(sv->ncodec_dirty[2]);
+    assert_int_equal(failed[2], 0);
 }
 
 
@@ -383,6 +437,7 @@ int run_ncodec_can_tests(void)
         cmocka_unit_test_setup_teardown(test_ncodec_can__read_empty, s, t),
         cmocka_unit_test_setup_teardown(test_ncodec_can__network_stream, s, t),
         cmocka_unit_test_setup_teardown(test_ncodec_can__truncate, s, t),
+        cmocka_unit_test_setup_teardown(test_ncodec_can__first_use, s, t),
         cmocka_unit_test_setup_teardown(test_ncodec_can__config, s, t),
         cmocka_unit_test_setup_teardown(test_ncodec_can__call_sequence, s, t),
     };
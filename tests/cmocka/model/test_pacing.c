@@ -0,0 +1,158 @@
+// Copyright 2026 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdint.h>
+#include <time.h>
+#include <dse/testing.h>
+#include <dse/modelc/runtime.h>
+#include <dse/modelc/controller/controller.h>
+
+
+#define UNUSED(x)    ((void)x)
+#define NSEC_PER_SEC 1000000000ULL
+#define STEP_NS      1000000ULL /* 1 ms */
+
+
+static uint64_t _now_ns(void)
+{
+    struct timespec ts = {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * NSEC_PER_SEC + (uint64_t)ts.tv_nsec;
+}
+
+
+static uint64_t _epoch_ns(ControllerPacing* pacing)
+{
+    return (uint64_t)pacing->epoch.tv_sec * NSEC_PER_SEC +
+           (uint64_t)pacing->epoch.tv_nsec;
+}
+
+
+void test_pacing__disabled(void** state)
+{
+    UNUSED(state);
+
+    SimulationSpec   sim = { .step_size = 0.001 };
+    ControllerPacing pacing;
+    controller_pacing_init(&pacing, &sim);
+    assert_false(pacing.enabled);
+
+    /* Wait and report are no-op. */
+    controller_pacing_wait(&pacing);
+    assert_int_equal(pacing.step_count, 0);
+    assert_int_equal(pacing.stats.steps, 0);
+    controller_pacing_report(&pacing);
+}
+
+
+void test_pacing__deadline(void** state)
+{
+    UNUSED(state);
+
+    ControllerPacing pacing = {
+        .enabled = true,
+        .step_ns = STEP_NS,
+        .busy_wait_ns = 100000,
+    };
+
+    /* First call sets the epoch. */
+    controller_pacing_wait(&pacing);
+    uint64_t epoch_ns = _epoch_ns(&pacing);
+    assert_int_equal(pacing.step_count, 1);
+
+    /* Each call returns at, or after, its step boundary. */
+    for (uint64_t i = 2; i <= 5; i++) {
+        controller_pacing_wait(&pacing);
+        assert_int_equal(pacing.step_count, i);
+        assert_true(_now_ns() >= epoch_ns + i * STEP_NS);
+    }
+    assert_int_equal(_epoch_ns(&pacing), epoch_ns);
+    assert_int_equal(pacing.stats.steps, 5);
+
+    uint64_t count = 0;
+    for (uint32_t i = 0; i < PACING_HISTOGRAM_BINS; i++) {
+        count += pacing.stats.histogram[i];
+    }
+    assert_int_equal(count, pacing.stats.steps);
+}
+
+
+void test_pacing__overrun(void** state)
+{
+    UNUSED(state);
+
+    ControllerPacing pacing = {
+        .enabled = true,
+        .step_ns = STEP_NS,
+    };
+    controller_pacing_wait(&pacing);
+    uint64_t steps = pacing.stats.steps;
+    uint64_t overrun = pacing.stats.overrun;
+
+    /* Move the epoch back by 10 steps, the next deadline is ~8 steps late. */
+    uint64_t epoch_ns = _epoch_ns(&pacing) - 10 * STEP_NS;
+    pacing.epoch = (struct timespec){
+        .tv_sec = (time_t)(epoch_ns / NSEC_PER_SEC),
+        .tv_nsec = (long)(epoch_ns % NSEC_PER_SEC),
+    };
+    controller_pacing_wait(&pacing);
+    assert_int_equal(pacing.stats.overrun, overrun + 1);
+    assert_int_equal(pacing.stats.steps, steps + 1);
+
+    /* Lateness is measured against the original deadline. */
+    assert_true(pacing.stats.lateness_max_ns >= 8 * STEP_NS);
+    assert_true(pacing.stats.lateness_sum_ns >= 8 * STEP_NS);
+
+    /* The epoch was shifted, the next step is paced normally. */
+    assert_true(_epoch_ns(&pacing) >= epoch_ns + 8 * STEP_NS);
+    assert_true(_epoch_ns(&pacing) + 2 * STEP_NS <= _now_ns());
+    controller_pacing_wait(&pacing);
+    assert_int_equal(pacing.stats.overrun, overrun + 1);
+    assert_true(_now_ns() >= _epoch_ns(&pacing) + 3 * STEP_NS);
+}
+
+
+void test_pacing__record(void** state)
+{
+    UNUSED(state);
+
+    ControllerPacing pacing = { .enabled = true, .step_ns = STEP_NS };
+
+    /* Log2 bins in microseconds. */
+    controller_pacing_record(&pacing, 0);
+    controller_pacing_record(&pacing, 999);
+    controller_pacing_record(&pacing, 1000);
+    controller_pacing_record(&pacing, 1999);
+    controller_pacing_record(&pacing, 2000);
+    controller_pacing_record(&pacing, 3999);
+    controller_pacing_record(&pacing, 4000);
+    controller_pacing_record(&pacing, 100 * NSEC_PER_SEC);
+    assert_int_equal(pacing.stats.histogram[0], 2);
+    assert_int_equal(pacing.stats.histogram[1], 2);
+    assert_int_equal(pacing.stats.histogram[2], 2);
+    assert_int_equal(pacing.stats.histogram[3], 1);
+    assert_int_equal(pacing.stats.histogram[PACING_HISTOGRAM_BINS - 1], 1);
+
+    assert_int_equal(pacing.stats.steps, 8);
+    assert_int_equal(pacing.stats.overrun, 0);
+    assert_int_equal(pacing.stats.lateness_max_ns, 100 * NSEC_PER_SEC);
+    assert_int_equal(pacing.stats.lateness_sum_ns,
+        0 + 999 + 1000 + 1999 + 2000 + 3999 + 4000 + 100 * NSEC_PER_SEC);
+
+    /* Report with populated statistics. */
+    controller_pacing_report(&pacing);
+}
+
+
+int run_pacing_tests(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_pacing__disabled),
+        cmocka_unit_test(test_pacing__deadline),
+        cmocka_unit_test(test_pacing__overrun),
+        cmocka_unit_test(test_pacing__record),
+    };
+
+    return cmocka_run_group_tests_name("PACING", tests, NULL, NULL);
+}
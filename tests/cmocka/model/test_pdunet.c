@@ -3,11 +3,13 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <math.h>
+#include <unistd.h>
 #include <dse/testing.h>
 #include <dse/logger.h>
 #include <dse/clib/util/yaml.h>
 #include <dse/modelc/model.h>
 #include <dse/modelc/schema.h>
+#include <dse/modelc/controller/model_private.h>
 #include <dse/modelc/model/pdunet/network.h>
 #include <dse/modelc/pdunet.h>
 #include <dse/mocks/simmock.h>
@@ -134,6 +136,34 @@ static int test_setup_secured(void** state)
 }
 
 
+static int test_setup_encoding(void** state)
+{
+    ModelCMock* mock = calloc(1, sizeof(ModelCMock));
+    assert_non_null(mock);
+
+    int             rc;
+    ModelCArguments args;
+    char*           argv[] = {
+        (char*)"test_pdunet",
+        (char*)"--name=can",
+        (char*)"resources/model/pdunet_encoding.yaml",
+    };
+
+    modelc_set_default_args(&args, "test", 0.005, 0.005);
+    args.log_level = __log_level__;
+    modelc_parse_arguments(&args, ARRAY_SIZE(argv), argv, "PDU-Network");
+    rc = modelc_configure(&args, &mock->sim);
+    assert_int_equal(rc, 0);
+    ModelInstanceSpec* mi = modelc_get_model_instance(&mock->sim, args.name);
+    assert_non_null(mi);
+    mock->mi = mi;
+
+    /* Return the mock. */
+    *state = mock;
+    return 0;
+}
+
+
 static int test_teardown(void** state)
 {
     ModelCMock* mock = *state;
@@ -681,6 +711,18 @@ void test_pdunet_pack_tx(void** state)
         [2] = 0x01,  // 100/x64, upper part
     };
     assert_memory_equal(o->ncodec.pdu.payload, payload, 64);
+
+    // Pack marks the changed payload, checksum is only set on Tx.
+    assert_true(o->changed);
+    pdunet_visit(net, NULL, pdunet_visit_needs_tx, NULL);
+    assert_true(o->needs_tx);
+    assert_false(o->changed);
+    assert_int_equal(o->checksum, pdunet_checksum(payload, 64));
+    // Unchanged raw values, no change.
+    pdunet_encode_pack(net, NULL);
+    assert_false(o->changed);
+    pdunet_visit(net, NULL, pdunet_visit_needs_tx, NULL);
+    assert_false(o->needs_tx);
 }
 
 
@@ -817,6 +859,20 @@ void test_pdunet_lua_tx(void** state)
     assert_int_equal(rc, 0);
     assert_int_equal(vector_len(&net->matrix.pdu), 6);
 
+    // Signals with Lua functions are in the scalar partition.
+    for (size_t i = 0; i < vector_len(&net->matrix.range); i++) {
+        PduRange* r = vector_at(&net->matrix.range, i, NULL);
+        size_t    scalar_count = 0;
+        for (size_t j = r->offset; j < r->offset + r->length; j++) {
+            lua_func_t* e = vector_at(&net->matrix.signal.encode, j, NULL);
+            lua_func_t* d = vector_at(&net->matrix.signal.decode, j, NULL);
+            uint8_t* linear = vector_at(&net->matrix.signal.linear, j, NULL);
+            if (*e > 0 || *d > 0) assert_int_equal(*linear, 0);
+            if (*linear == 0) scalar_count++;
+        }
+        assert_int_equal(vector_len(&r->scalar_list), scalar_count);
+    }
+
     matrix_check signal_checks[] = {
         // clang-format off
         { .idx = 4, .pdu_idx = 2, .signal_idx = 1, .name = "Alive",
@@ -981,6 +1037,124 @@ void test_pdunet_lua_rx(void** state)
 }
 
 
+void test_pdunet_lua_range(void** state)
+{
+    ModelCMock* mock = *state;
+    int         rc = 0;
+    assert_non_null(mock->mi);
+
+    PduNetworkDesc* net =
+        pdunet_create(mock->mi, NULL, NULL, NULL, NULL, NULL);
+    mock->net = net;  // Teardown will destroy.
+    SchemaLabel labels[] = {
+        { .name = "name", .value = "FlexRay" },
+        { .name = "model", .value = "flexray" },
+        {},
+    };
+    rc = pdunet_parse(net, labels);
+    assert_int_equal(rc, 0);
+    rc = pdunet_configure(net);
+    assert_int_equal(rc, 0);
+
+    // Load a function which operates on a range of signals.
+    ModelInstancePrivate* mip = mock->mi->private;
+    lua_State*            L = mip->lua_state;
+    assert_non_null(L);
+    int top = lua_gettop(L);
+    rc = luaL_dostring(L,
+        "return function(ctx)\n"
+        "  if ctx.phys[1] < 0 then\n"
+        "    ctx.err = 1\n"
+        "    ctx.errmsg = 'negative'\n"
+        "    return ctx\n"
+        "  end\n"
+        "  for i = 1, #ctx.phys do\n"
+        "    ctx.phys[i] = ctx.phys[i] * 2\n"
+        "    ctx.raw[i] = ctx.raw[i] + i\n"
+        "  end\n"
+        "  ctx.payload[1] = #ctx.phys\n"
+        "  ctx.calls = (ctx.calls or 0) + 1\n"
+        "  ctx.payload[2] = ctx.calls\n"
+        "  return ctx\n"
+        "end\n");
+    assert_int_equal(rc, 0);
+    int32_t ref = luaL_ref(L, LUA_REGISTRYINDEX);
+    assert_true(ref > 0);
+
+    double   phys[3] = { 1, 2, 3 };
+    uint64_t raw[3] = { 10, 20, 30 };
+    uint8_t  payload[4] = {};
+    rc = pdunet_lua_signal_range_call(L, ref, 100, phys, raw, 3, payload, 4);
+    assert_int_equal(rc, 0);
+    assert_double_equal(phys[0], 2, 0);
+    assert_double_equal(phys[2], 6, 0);
+    assert_int_equal(raw[0], 11);
+    assert_int_equal(raw[2], 33);
+    assert_int_equal(payload[0], 3);
+
+    // The ctx is reused, an err is reported once and then cleared.
+    phys[0] = -1;
+    rc = pdunet_lua_signal_range_call(L, ref, 100, phys, raw, 3, payload, 4);
+    assert_int_equal(rc, -1);
+    phys[0] = 1;
+    rc = pdunet_lua_signal_range_call(L, ref, 100, phys, raw, 2, payload, 4);
+    assert_int_equal(rc, 0);
+    assert_double_equal(phys[0], 2, 0);
+    assert_double_equal(phys[1], 8, 0);
+    assert_double_equal(phys[2], 6, 0);
+    assert_int_equal(payload[0], 2);
+    assert_int_equal(payload[1], 2);  // Fields set by the function persist.
+    assert_int_equal(lua_gettop(L), top);
+
+    // Bad parameters.
+    rc = pdunet_lua_signal_range_call(L, ref, 100, NULL, raw, 3, payload, 4);
+    assert_int_equal(rc, -EINVAL);
+
+    // Public API, the signals of a PDU Object.
+    rc = pdunet_transform(net, NULL);
+    assert_int_equal(rc, 0);
+    PduObject* pdu = NULL;
+    PduObject* other = NULL;
+    for (size_t i = 0; i < vector_len(&net->matrix.pdu); i++) {
+        PduObject* o = vector_at(&net->matrix.pdu, i, NULL);
+        if (o->matrix.range.count == 0) continue;
+        if (pdu == NULL && o->matrix.range.count > 1) {
+            pdu = o;
+        } else if (other == NULL) {
+            other = o;
+        }
+    }
+    assert_non_null(pdu);
+    assert_non_null(other);
+    size_t count = pdu->matrix.range.count;
+    assert_true(count > 1);
+    double* pdu_phys =
+        vector_at(&net->matrix.signal.phys, pdu->matrix.range.offset, NULL);
+    uint64_t* pdu_raw =
+        vector_at(&net->matrix.signal.raw, pdu->matrix.range.offset, NULL);
+    for (size_t i = 0; i < count; i++) {
+        pdu_phys[i] = i + 1;
+        pdu_raw[i] = 0;
+    }
+    rc = pdunet_call_signal_range_func(net, pdu, ref);
+    assert_int_equal(rc, 0);
+    for (size_t i = 0; i < count; i++) {
+        assert_double_equal(pdu_phys[i], (i + 1) * 2, 0);
+        assert_int_equal(pdu_raw[i], i + 1);
+    }
+    assert_int_equal(pdu->ncodec.pdu.payload[0], count);
+    // Each PDU Object has its own ctx (ctx.calls).
+    assert_int_equal(pdu->ncodec.pdu.payload[1], 1);
+    assert_int_equal(pdunet_call_signal_range_func(net, other, ref), 0);
+    assert_int_equal(other->ncodec.pdu.payload[1], 1);
+    assert_int_equal(pdunet_call_signal_range_func(net, pdu, ref), 0);
+    assert_int_equal(pdu->ncodec.pdu.payload[1], 2);
+    assert_int_equal(pdunet_call_signal_range_func(net, pdu, 0), -EINVAL);
+    assert_int_equal(pdunet_call_signal_range_func(net, NULL, ref), -EINVAL);
+    luaL_unref(L, LUA_REGISTRYINDEX, ref);
+}
+
+
 void test_pdunet_container_tx(void** state)
 {
     ModelCMock* mock = *state;
@@ -1476,12 +1650,1347 @@ void test_pdunet_secured_pdu_rx(void** state)
 }
 
 
+void test_pdunet_pack_byte_order_signed(void** state)
+{
+    ModelCMock* mock = *state;
+    int         rc = 0;
+    assert_non_null(mock->mi);
+
+    void*           ncodec = NULL;
+    PduNetworkDesc* net =
+        pdunet_create(mock->mi, ncodec, NULL, NULL, NULL, NULL);
+    mock->net = net;  // Teardown will destroy.
+    SchemaLabel labels[] = {
+        { .name = "name", .value = "Encoding" },
+        {},
+    };
+    rc = pdunet_parse(net, labels);
+    assert_int_equal(rc, 0);
+    assert_int_equal(vector_len(&net->pdus), 2);
+    PduItem* pdu = vector_at(&net->pdus, 1, NULL);
+    assert_int_equal(vector_len(&pdu->signals), 3);
+    PduSignalItem* s = vector_at(&pdu->signals, 2, NULL);
+    assert_string_equal(s->name, "SIG_MS_RX");
+    assert_int_equal(s->byte_order, PduByteOrderBigEndian);
+    assert_true(s->is_signed);
+    pdunet_transform(net, NULL);
+    assert_int_equal(vector_len(&net->matrix.pdu), 2);
+
+    // Encode and pack (matrix: Rx PDU signals 0..2, Tx PDU signals 3..5).
+    matrix_check tx[] = {
+        { .idx = 3, .name = "SIG_M_TX", .phys = 4660, .raw = 0x1234 },
+        { .idx = 4, .name = "SIG_S_TX", .phys = -10, .raw = (uint64_t)-20 },
+        { .idx = 5, .name = "SIG_MS_TX", .phys = -2, .raw = (uint64_t)-2 },
+    };
+    for (size_t i = 0; i < ARRAY_SIZE(tx); i++) {
+        matrix_check c = tx[i];
+        assert_string_equal(
+            *(const char**)vector_at(&net->matrix.signal.name, c.idx, NULL),
+            c.name);
+        *(double*)vector_at(&net->matrix.signal.phys, c.idx, NULL) = c.phys;
+    }
+    pdunet_encode_linear(net, NULL);
+    for (size_t i = 0; i < ARRAY_SIZE(tx); i++) {
+        matrix_check c = tx[i];
+        assert_int_equal(
+            *(uint64_t*)vector_at(&net->matrix.signal.raw, c.idx, NULL), c.raw);
+    }
+    pdunet_encode_pack(net, NULL);
+    PduObject* o_tx = vector_at(&net->matrix.pdu, 1, NULL);
+    assert_int_equal(o_tx->pdu->id, 1);
+    uint8_t payload[8] = {
+        [0] = 0x12,  // SIG_M_TX, MSB first.
+        [1] = 0x34,
+        [2] = 0xec,  // SIG_S_TX, -20 (12 bit).
+        [3] = 0x0f,
+        [4] = 0xfe,  // SIG_MS_TX, -2.
+    };
+    assert_memory_equal(o_tx->ncodec.pdu.payload, payload, 8);
+
+    // Unpack and decode.
+    PduObject* o_rx = vector_at(&net->matrix.pdu, 0, NULL);
+    assert_int_equal(o_rx->pdu->id, 2);
+    memcpy(o_rx->ncodec.pdu.payload, payload, 8);
+    pdunet_decode_unpack(net, NULL);
+    pdunet_decode_linear(net, NULL);
+    matrix_check rx[] = {
+        { .idx = 0, .name = "SIG_M_RX", .phys = 4660, .raw = 0x1234 },
+        { .idx = 1, .name = "SIG_S_RX", .phys = -10, .raw = (uint64_t)-20 },
+        { .idx = 2, .name = "SIG_MS_RX", .phys = -2, .raw = (uint64_t)-2 },
+    };
+    for (size_t i = 0; i < ARRAY_SIZE(rx); i++) {
+        matrix_check c = rx[i];
+        assert_string_equal(
+            *(const char**)vector_at(&net->matrix.signal.name, c.idx, NULL),
+            c.name);
+        assert_int_equal(
+            *(uint64_t*)vector_at(&net->matrix.signal.raw, c.idx, NULL), c.raw);
+        assert_double_equal(
+            *(double*)vector_at(&net->matrix.signal.phys, c.idx, NULL), c.phys,
+            0);
+    }
+}
+
+
+void test_pdunet_schedule_queue(void** state)
+{
+    ModelCMock* mock = *state;
+    int         rc = 0;
+    assert_non_null(mock->mi);
+
+    void*           ncodec = NULL;
+    PduNetworkDesc* net =
+        pdunet_create(mock->mi, ncodec, NULL, NULL, NULL, NULL);
+    mock->net = net;  // Teardown will destroy.
+    net->schedule.step_size = 0.5;
+
+    PduItem pdus[] = {
+        { .name = "P2", .id = 2, .dir = PduDirectionTx,
+            .schedule = { .interval = 1.0,
+                .trigger = PduScheduleTriggerPeriodic } },
+        { .name = "P3", .id = 3, .dir = PduDirectionTx,
+            .schedule = { .interval = 1.5,
+                .trigger = PduScheduleTriggerPeriodic } },
+        { .name = "P4", .id = 4, .dir = PduDirectionTx },
+        { .name = "P5", .id = 5, .dir = PduDirectionRx },
+    };
+    for (size_t i = 0; i < ARRAY_SIZE(pdus); i++) {
+        vector_push(&net->pdus, &pdus[i]);
+    }
+    rc = pdunet_transform(net, NULL);
+    assert_int_equal(rc, 0);
+
+    // Find the PDU Objects (matrix is sorted).
+    PduObject* o[ARRAY_SIZE(pdus) + 2] = {};
+    for (size_t i = 0; i < vector_len(&net->matrix.pdu); i++) {
+        PduObject* _ = vector_at(&net->matrix.pdu, i, NULL);
+        o[_->pdu->id] = _;
+    }
+
+    // Periodic PDUs which fire have their checksum cleared.
+    struct {
+        uint32_t time;
+        bool     fired[2]; /* P2, P3 */
+    } checks[] = {
+        { 0, { true, true } },
+        { 1, { false, false } },
+        { 2, { true, false } },
+        { 3, { false, true } },
+        { 4, { true, false } },
+        { 6, { true, true } },
+        { 9, { false, true } }, /* Steps skipped. */
+        { 4, { true, false } }, /* Time moved backwards. */
+    };
+    for (size_t i = 0; i < ARRAY_SIZE(checks); i++) {
+        o[2]->checksum = o[3]->checksum = 42;
+        net->schedule.simulation_time = checks[i].time;
+        pdunet_schedule(net);
+        log_info("Check[%u]: time=%u", i, checks[i].time);
+        assert_int_equal(o[2]->checksum == 0, checks[i].fired[0]);
+        assert_int_equal(o[3]->checksum == 0, checks[i].fired[1]);
+    }
+    assert_int_equal(vector_len(&net->schedule.tx.queue), 2);
+    assert_int_equal(vector_len(&net->schedule.tx.on_change), 1);
+}
+
+
+void test_pdunet_schedule_idle(void** state)
+{
+    ModelCMock* mock = *state;
+    int         rc = 0;
+    assert_non_null(mock->mi);
+
+    void*           ncodec = NULL;
+    PduNetworkDesc* net =
+        pdunet_create(mock->mi, ncodec, NULL, NULL, NULL, NULL);
+    mock->net = net;  // Teardown will destroy.
+    net->schedule.step_size = 0.5;
+
+    PduItem pdus[] = {
+        { .name = "P2", .id = 2, .dir = PduDirectionTx,
+            .schedule = { .interval = 1.0,
+                .trigger = PduScheduleTriggerPeriodic } },
+        { .name = "P3", .id = 3, .dir = PduDirectionTx,
+            .schedule = { .interval = 1.5,
+                .trigger = PduScheduleTriggerPeriodic } },
+        { .name = "P4", .id = 4, .dir = PduDirectionTx },
+    };
+    for (size_t i = 0; i < ARRAY_SIZE(pdus); i++) {
+        vector_push(&net->pdus, &pdus[i]);
+    }
+    rc = pdunet_transform(net, NULL);
+    assert_int_equal(rc, 0);
+
+    // Schedule not built, not idle.
+    net->schedule.simulation_time = 0;
+    assert_false(pdunet_schedule_idle(net));
+
+    struct {
+        uint32_t time;
+        bool     idle;
+    } checks[] = {
+        { 0, false },
+        { 1, true },
+        { 2, false },
+        { 3, false },
+        { 4, false },
+        { 5, true },
+        { 9, false }, /* Steps skipped. */
+        { 4, false }, /* Time moved backwards. */
+    };
+    for (size_t i = 0; i < ARRAY_SIZE(checks); i++) {
+        net->schedule.simulation_time = checks[i].time;
+        log_info("Check[%u]: time=%u", i, checks[i].time);
+        assert_int_equal(pdunet_schedule_idle(net), checks[i].idle);
+        pdunet_schedule(net);
+    }
+
+    // Pending Tx (e.g. L-PDU status) is not idle.
+    net->schedule.simulation_time = 5;
+    assert_true(pdunet_schedule_idle(net));
+    net->schedule.tx.pending = true;
+    assert_false(pdunet_schedule_idle(net));
+}
+
+
+typedef struct RangeVisit {
+    PduRange* range;
+    size_t    count;
+} RangeVisit;
+
+static void _visit_range_check(
+    PduNetworkDesc* net, PduObject* pdu, void* data)
+{
+    assert_non_null(net);
+    assert_non_null(data);
+    RangeVisit* v = data;
+    assert_ptr_equal(pdu->matrix.pdu_range, v->range);
+    assert_int_equal(pdu->pdu->dir, v->range->dir);
+    assert_true(pdunet_in_range(net, pdu));
+    v->count++;
+}
+
+
+void test_pdunet_range(void** state)
+{
+    ModelCMock* mock = *state;
+    int         rc = 0;
+    assert_non_null(mock->mi);
+
+    void*           ncodec = NULL;
+    PduNetworkDesc* net =
+        pdunet_create(mock->mi, ncodec, NULL, NULL, NULL, NULL);
+    mock->net = net;  // Teardown will destroy.
+    SchemaLabel labels[] = {
+        { .name = "name", .value = "FlexRay" },
+        { .name = "model", .value = "flexray" },
+        {},
+    };
+    rc = pdunet_parse(net, labels);
+    assert_int_equal(rc, 0);
+    pdunet_transform(net, NULL);
+    assert_int_equal(vector_len(&net->matrix.range), 2);
+
+    // Each range visits only its own PDUs.
+    size_t pdu_count = 0;
+    for (size_t i = 0; i < vector_len(&net->matrix.range); i++) {
+        PduRange*  r = vector_at(&net->matrix.range, i, NULL);
+        RangeVisit v = { .range = r };
+        net->range = r;
+        pdunet_visit(net, r, _visit_range_check, &v);
+        assert_int_equal(v.count, vector_len(&r->pdu_list));
+        assert_int_equal(pdunet_range_count(net), vector_len(&r->pdu_list));
+        pdu_count += v.count;
+    }
+    net->range = NULL;
+    assert_int_equal(pdu_count, vector_len(&net->matrix.pdu));
+    assert_int_equal(pdunet_range_count(net), vector_len(&net->matrix.pdu));
+
+    // PDUs of the other range are excluded.
+    PduRange* r0 = vector_at(&net->matrix.range, 0, NULL);
+    PduRange* r1 = vector_at(&net->matrix.range, 1, NULL);
+    size_t    pdu_idx = *(size_t*)vector_at(&r1->pdu_list, 0, NULL);
+    PduObject* o = vector_at(&net->matrix.pdu, pdu_idx, NULL);
+    net->range = r0;
+    assert_false(pdunet_in_range(net, o));
+    net->range = NULL;
+    assert_true(pdunet_in_range(net, o));
+}
+
+
+static void _assert_str_equal(const char* a, const char* b)
+{
+    if (a == NULL || b == NULL) {
+        assert_ptr_equal(a, b);
+    } else {
+        assert_string_equal(a, b);
+    }
+}
+
+void test_pdunet_cache(void** state)
+{
+    ModelCMock* mock = *state;
+    int         rc = 0;
+    assert_non_null(mock->mi);
+
+    const char*     path = "pdunet_cache.bin";
+    void*           ncodec = NULL;
+    PduNetworkDesc* net =
+        pdunet_create(mock->mi, ncodec, NULL, NULL, NULL, NULL);
+    mock->net = net;  // Teardown will destroy.
+    SchemaLabel labels[] = {
+        { .name = "name", .value = "FlexRay" },
+        { .name = "model", .value = "flexray" },
+        {},
+    };
+    rc = pdunet_parse(net, labels);
+    assert_int_equal(rc, 0);
+    assert_int_equal(vector_len(&net->pdus), 4);
+    rc = pdunet_cache_save(net, path);
+    assert_int_equal(rc, 0);
+
+    // Saved via a temporary file (renamed into place), which also replaces
+    // an existing cache file.
+    char tmp_path[100];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.%ld.tmp", path, (long)getpid());
+    assert_int_equal(access(tmp_path, F_OK), -1);
+    assert_int_equal(access(path, F_OK), 0);
+    rc = pdunet_cache_save(net, path);
+    assert_int_equal(rc, 0);
+    assert_int_equal(access(tmp_path, F_OK), -1);
+    assert_int_not_equal(
+        pdunet_cache_save(net, "missing_dir/pdunet_cache.bin"), 0);
+    assert_int_equal(access("missing_dir/pdunet_cache.bin", F_OK), -1);
+
+    // Load the cache (same Network YAML).
+    PduNetworkDesc* cache_net =
+        pdunet_create(mock->mi, ncodec, NULL, NULL, NULL, NULL);
+    cache_net->doc = net->doc;
+    cache_net->network.transport_type = net->network.transport_type;
+    rc = pdunet_cache_load(cache_net, path);
+    assert_int_equal(rc, 0);
+    assert_non_null(cache_net->cache.data);
+    assert_int_equal(vector_len(&cache_net->pdus), vector_len(&net->pdus));
+    for (size_t i = 0; i < vector_len(&net->pdus); i++) {
+        PduItem* pdu = vector_at(&net->pdus, i, NULL);
+        PduItem* c_pdu = vector_at(&cache_net->pdus, i, NULL);
+        _assert_str_equal(c_pdu->name, pdu->name);
+        assert_int_equal(c_pdu->id, pdu->id);
+        assert_int_equal(c_pdu->length, pdu->length);
+        assert_int_equal(c_pdu->dir, pdu->dir);
+        assert_int_equal(c_pdu->container.header, pdu->container.header);
+        assert_int_equal(c_pdu->container.id, pdu->container.id);
+        assert_int_equal(c_pdu->container.priority, pdu->container.priority);
+        assert_double_equal(c_pdu->schedule.phase, pdu->schedule.phase, 0);
+        assert_double_equal(
+            c_pdu->schedule.interval, pdu->schedule.interval, 0);
+        assert_int_equal(c_pdu->schedule.trigger, pdu->schedule.trigger);
+        _assert_str_equal(c_pdu->lua.encode, pdu->lua.encode);
+        _assert_str_equal(c_pdu->lua.decode, pdu->lua.decode);
+        _assert_str_equal(c_pdu->lua.tx, pdu->lua.tx);
+        _assert_str_equal(c_pdu->lua.rx, pdu->lua.rx);
+        if (pdu->metadata.config) {
+            assert_non_null(c_pdu->metadata.config);
+            assert_memory_equal(c_pdu->metadata.config, pdu->metadata.config,
+                sizeof(NCodecPduFlexrayLpduConfig));
+        } else {
+            assert_null(c_pdu->metadata.config);
+        }
+        assert_int_equal(
+            vector_len(&c_pdu->signals), vector_len(&pdu->signals));
+        for (size_t j = 0; j < vector_len(&pdu->signals); j++) {
+            PduSignalItem* sig = vector_at(&pdu->signals, j, NULL);
+            PduSignalItem* c_sig = vector_at(&c_pdu->signals, j, NULL);
+            _assert_str_equal(c_sig->name, sig->name);
+            assert_int_equal(c_sig->start_bit, sig->start_bit);
+            assert_int_equal(c_sig->length_bits, sig->length_bits);
+            assert_int_equal(c_sig->byte_order, sig->byte_order);
+            assert_int_equal(c_sig->is_signed, sig->is_signed);
+            assert_memory_equal(&c_sig->factor, &sig->factor, sizeof(double));
+            assert_memory_equal(&c_sig->offset, &sig->offset, sizeof(double));
+            assert_memory_equal(&c_sig->min, &sig->min, sizeof(double));
+            assert_memory_equal(&c_sig->max, &sig->max, sizeof(double));
+            _assert_str_equal(c_sig->lua.encode, sig->lua.encode);
+            _assert_str_equal(c_sig->lua.decode, sig->lua.decode);
+        }
+    }
+    // Cached network transforms like the parsed network.
+    rc = pdunet_transform(cache_net, NULL);
+    assert_int_equal(rc, 0);
+    assert_int_equal(cache_net->matrix.signal.count, 8);
+    // PDUs already loaded.
+    assert_int_equal(pdunet_cache_load(cache_net, path), EBUSY);
+    pdunet_destroy(cache_net);
+
+    // Mismatched network (transport) is rejected.
+    PduNetworkDesc* other_net =
+        pdunet_create(mock->mi, ncodec, NULL, NULL, NULL, NULL);
+    other_net->doc = net->doc;
+    other_net->network.transport_type = NCodecPduTransportTypeCan;
+    assert_int_not_equal(pdunet_cache_load(other_net, path), 0);
+    assert_int_equal(vector_len(&other_net->pdus), 0);
+    assert_null(other_net->cache.data);
+    pdunet_destroy(other_net);
+
+    // Missing file.
+    remove(path);
+    PduNetworkDesc* missing_net =
+        pdunet_create(mock->mi, ncodec, NULL, NULL, NULL, NULL);
+    missing_net->doc = net->doc;
+    missing_net->network.transport_type = net->network.transport_type;
+    assert_int_equal(pdunet_cache_load(missing_net, path), ENOENT);
+    pdunet_destroy(missing_net);
+}
+
+
+void test_pdunet_e2e(void** state)
+{
+    UNUSED(state);
+
+    // CRC check values ("123456789").
+    const uint8_t check[] = "123456789";
+    assert_int_equal(pdunet_e2e_crc(PduE2eProfileCrc8, check, 9), 0x4B);
+    assert_int_equal(pdunet_e2e_crc(PduE2eProfileCrc16, check, 9), 0x29B1);
+    assert_int_equal(
+        pdunet_e2e_crc(PduE2eProfileCrc32, check, 9), 0x1697D06A);
+
+    PduE2eProfile profiles[] = {
+        PduE2eProfileCrc8, PduE2eProfileCrc16, PduE2eProfileCrc32 };
+    for (size_t i = 0; i < ARRAY_SIZE(profiles); i++) {
+        PduItem pdu = {
+            .name = "E2E",
+            .length = 8,
+            .e2e = {
+                .profile = profiles[i],
+                .data_id = 0x1234,
+                .crc_offset = 0,
+                .counter = { .offset = 4, .bits = 4 },
+            },
+        };
+        assert_true(pdunet_e2e_validate(&pdu));
+        PduObject tx = { .pdu = &pdu };
+        PduObject rx = { .pdu = &pdu };
+        uint8_t   payload[8] = { 0, 0, 0, 0, 0xA0, 0x11, 0x22, 0x33 };
+
+        // Protect, counter in the low nibble (high nibble preserved).
+        for (uint8_t counter = 0; counter < 20; counter++) {
+            pdunet_e2e_protect(&tx, payload, sizeof(payload));
+            assert_int_equal(payload[4], 0xA0 | (counter & 0x0f));
+            assert_int_equal(
+                pdunet_e2e_check(&rx, payload, sizeof(payload)), 0);
+        }
+        assert_int_equal(rx.e2e.errors, 0);
+        // Repeated counter.
+        assert_int_equal(
+            pdunet_e2e_check(&rx, payload, sizeof(payload)), EALREADY);
+        // Corrupted payload.
+        pdunet_e2e_protect(&tx, payload, sizeof(payload));
+        payload[6] ^= 0x01;
+        assert_int_equal(
+            pdunet_e2e_check(&rx, payload, sizeof(payload)), EBADMSG);
+        // Wrong Data ID.
+        payload[6] ^= 0x01;
+        pdu.e2e.data_id = 0x1235;
+        assert_int_equal(
+            pdunet_e2e_check(&rx, payload, sizeof(payload)), EBADMSG);
+        // Short payload.
+        pdu.e2e.data_id = 0x1234;
+        assert_int_equal(pdunet_e2e_check(&rx, payload, 2), EBADMSG);
+        assert_int_equal(rx.e2e.errors, 4);
+        assert_int_equal(pdunet_e2e_check(&rx, payload, sizeof(payload)), 0);
+    }
+
+    // Invalid configuration disables protection.
+    PduItem pdu = {
+        .name = "E2E",
+        .length = 4,
+        .e2e = {
+            .profile = PduE2eProfileCrc32,
+            .crc_offset = 0,
+            .counter = { .offset = 2, .bits = 4 },
+        },
+    };
+    __log_level__ = LOG_QUIET;
+    assert_false(pdunet_e2e_validate(&pdu));
+    assert_int_equal(pdu.e2e.profile, PduE2eProfileNone);
+}
+
+
+static void _set_phys(PduNetworkDesc* net, size_t idx, const char* name,
+    double phys)
+{
+    assert_string_equal(
+        *(const char**)vector_at(&net->matrix.signal.name, idx, NULL), name);
+    *(double*)vector_at(&net->matrix.signal.phys, idx, NULL) = phys;
+}
+
+static double _get_phys(PduNetworkDesc* net, size_t idx, const char* name)
+{
+    assert_string_equal(
+        *(const char**)vector_at(&net->matrix.signal.name, idx, NULL), name);
+    return *(double*)vector_at(&net->matrix.signal.phys, idx, NULL);
+}
+
+void test_pdunet_multiplex(void** state)
+{
+    ModelCMock* mock = *state;
+    int         rc = 0;
+    assert_non_null(mock->mi);
+
+    void*           ncodec = NULL;
+    PduNetworkDesc* net =
+        pdunet_create(mock->mi, ncodec, NULL, NULL, NULL, NULL);
+    mock->net = net;  // Teardown will destroy.
+    SchemaLabel labels[] = {
+        { .name = "name", .value = "Multiplex" },
+        {},
+    };
+    rc = pdunet_parse(net, labels);
+    assert_int_equal(rc, 0);
+    assert_int_equal(vector_len(&net->pdus), 2);
+    PduItem*       pdu = vector_at(&net->pdus, 0, NULL);
+    PduSignalItem* s = vector_at(&pdu->signals, 0, NULL);
+    assert_true(s->mux.selector);
+    assert_false(s->mux.muxed);
+    s = vector_at(&pdu->signals, 1, NULL);
+    assert_true(s->mux.muxed);
+    assert_int_equal(s->mux.value, 1);
+    rc = pdunet_transform(net, NULL);
+    assert_int_equal(rc, 0);
+
+    // Matrix: Rx PDU signals 0..4, Tx PDU signals 5..9. Multiplexed signals
+    // follow the other signals, ordered by selector value.
+    PduObject* o_tx = vector_at(&net->matrix.pdu, 1, NULL);
+    assert_int_equal(o_tx->pdu->id, 3);
+    assert_int_equal(o_tx->mux.selector, 5);
+    assert_int_equal(vector_len(&o_tx->mux.group), 2);
+    PduMuxGroup* g = vector_at(&o_tx->mux.group, 0, NULL);
+    assert_int_equal(g->value, 0);
+    assert_int_equal(g->offset, 7);
+    assert_int_equal(g->count, 2);
+    g = vector_at(&o_tx->mux.group, 1, NULL);
+    assert_int_equal(g->value, 1);
+    assert_int_equal(g->offset, 9);
+    assert_int_equal(g->count, 1);
+    uint8_t* inactive = vector_at(&net->matrix.signal.inactive, 0, NULL);
+    uint8_t  expect_inactive[] = { 0, 0, 1, 1, 1, 0, 0, 1, 1, 1 };
+    assert_memory_equal(inactive, expect_inactive, 10);
+
+    // Tx selector 0.
+    _set_phys(net, 5, "MODE_TX", 0);
+    _set_phys(net, 6, "C_TX", 0x11);
+    _set_phys(net, 7, "A0_TX", 0x1234);
+    _set_phys(net, 8, "B0_TX", 0x56);
+    _set_phys(net, 9, "A1_TX", 0x78);
+    pdunet_encode_linear(net, NULL);
+    pdunet_encode_pack(net, NULL);
+    uint8_t payload_0[8] = { 0x00, 0x34, 0x12, 0x56, 0, 0, 0, 0x11 };
+    assert_memory_equal(o_tx->ncodec.pdu.payload, payload_0, 8);
+    assert_int_equal(o_tx->mux.active, 0);
+
+    // Tx selector 1, the group 0 signals are cleared.
+    o_tx->changed = false;
+    _set_phys(net, 5, "MODE_TX", 1);
+    pdunet_encode_linear(net, NULL);
+    pdunet_encode_pack(net, NULL);
+    uint8_t payload_1[8] = { 0x01, 0x78, 0x00, 0x00, 0, 0, 0, 0x11 };
+    assert_memory_equal(o_tx->ncodec.pdu.payload, payload_1, 8);
+    assert_int_equal(o_tx->mux.active, 1);
+    assert_true(o_tx->changed);
+
+    // Rx selector 1, only the active group is decoded.
+    PduObject* o_rx = vector_at(&net->matrix.pdu, 0, NULL);
+    assert_int_equal(o_rx->pdu->id, 4);
+    memcpy(o_rx->ncodec.pdu.payload, payload_1, 8);
+    pdunet_decode_unpack(net, NULL);
+    pdunet_decode_linear(net, NULL);
+    assert_double_equal(_get_phys(net, 0, "MODE_RX"), 1, 0);
+    assert_double_equal(_get_phys(net, 1, "C_RX"), 0x11, 0);
+    assert_double_equal(_get_phys(net, 2, "A0_RX"), 0, 0);
+    assert_double_equal(_get_phys(net, 3, "B0_RX"), 0, 0);
+    assert_double_equal(_get_phys(net, 4, "A1_RX"), 0x78, 0);
+
+    // Rx selector 0, inactive signals retain their value.
+    memcpy(o_rx->ncodec.pdu.payload, payload_0, 8);
+    pdunet_decode_unpack(net, NULL);
+    pdunet_decode_linear(net, NULL);
+    assert_double_equal(_get_phys(net, 0, "MODE_RX"), 0, 0);
+    assert_double_equal(_get_phys(net, 2, "A0_RX"), 0x1234, 0);
+    assert_double_equal(_get_phys(net, 3, "B0_RX"), 0x56, 0);
+    assert_double_equal(_get_phys(net, 4, "A1_RX"), 0x78, 0);
+
+    // Unknown selector value, no group is active.
+    payload_0[0] = 0x07;
+    memcpy(o_rx->ncodec.pdu.payload, payload_0, 8);
+    pdunet_decode_unpack(net, NULL);
+    assert_int_equal(o_rx->mux.active, SIZE_MAX);
+    assert_memory_equal(inactive, expect_inactive, 5);
+}
+
+
+static PduObject* _find_pdu(PduNetworkDesc* net, uint32_t id)
+{
+    for (size_t i = 0; i < vector_len(&net->matrix.pdu); i++) {
+        PduObject* o = vector_at(&net->matrix.pdu, i, NULL);
+        if (o->pdu->id == id) return o;
+    }
+    return NULL;
+}
+
+void test_pdunet_route(void** state)
+{
+    ModelCMock* mock = *state;
+    int         rc = 0;
+    assert_non_null(mock->mi);
+
+    // Source network (Rx PDU MUX_RX).
+    void*           ncodec = NULL;
+    PduNetworkDesc* net =
+        pdunet_create(mock->mi, ncodec, NULL, NULL, NULL, NULL);
+    mock->net = net;  // Teardown will destroy.
+    SchemaLabel labels[] = {
+        { .name = "name", .value = "Multiplex" },
+        {},
+    };
+    rc = pdunet_parse(net, labels);
+    assert_int_equal(rc, 0);
+    rc = pdunet_transform(net, NULL);
+    assert_int_equal(rc, 0);
+
+    // Routed network.
+    PduNetworkDesc* route_net =
+        pdunet_create(mock->mi, ncodec, NULL, NULL, NULL, NULL);
+    SchemaLabel route_labels[] = {
+        { .name = "name", .value = "Route" },
+        {},
+    };
+    rc = pdunet_parse(route_net, route_labels);
+    assert_int_equal(rc, 0);
+    PduItem* pdu = vector_at(&route_net->pdus, 0, NULL);
+    assert_string_equal(pdu->route.network, "CAN_MUX");
+    assert_string_equal(pdu->route.pdu, "MUX_RX");
+    rc = pdunet_transform(route_net, NULL);
+    assert_int_equal(rc, 0);
+
+    // Link, BAD_TX is not linked (source is not an Rx PDU).
+    assert_int_equal(pdunet_route_link(route_net, net), 2);
+    assert_int_equal(pdunet_route_link(net, route_net), 0);
+    assert_int_equal(vector_len(&route_net->route.list), 2);
+    PduObject* o_rx = _find_pdu(net, 4);
+    PduObject* o_route = _find_pdu(route_net, 5);
+    PduObject* o_raw = _find_pdu(route_net, 6);
+    PduObject* o_bad = _find_pdu(route_net, 7);
+    assert_ptr_equal(o_route->route.source, o_rx);
+    assert_ptr_equal(o_raw->route.source, o_rx);
+    assert_null(o_bad->route.source);
+    assert_false(pdunet_route_pending(route_net));
+
+    // Rx, the accepted PDU is routed.
+    uint8_t payload[8] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+    rc = pdunet_call_rx_func(net, o_rx, payload, sizeof(payload));
+    assert_int_equal(rc, 0);
+    memcpy(o_rx->ncodec.pdu.payload, payload, sizeof(payload));
+    assert_int_equal(o_rx->route.rx_count, 1);
+    assert_true(pdunet_route_pending(route_net));
+    o_route->checksum = 42;
+    pdunet_route(route_net);
+    assert_false(pdunet_route_pending(route_net));
+    assert_memory_equal(o_route->ncodec.pdu.payload, payload, 8);
+    assert_memory_equal(o_raw->ncodec.pdu.payload, payload, 4);
+    assert_true(o_route->changed);
+    assert_true(o_raw->changed);
+    assert_int_equal(o_route->checksum, 0);
+
+    // Signals of the routed PDU patch the payload.
+    _set_phys(route_net, 0, "PATCH_TX", 0x55);
+    pdunet_encode_linear(route_net, NULL);
+    pdunet_encode_pack(route_net, NULL);
+    uint8_t patched[8] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x55 };
+    assert_memory_equal(o_route->ncodec.pdu.payload, patched, 8);
+
+    // No Rx, no route.
+    o_raw->changed = false;
+    o_raw->ncodec.pdu.payload[0] = 0xff;
+    pdunet_route(route_net);
+    assert_false(o_raw->changed);
+    assert_int_equal(o_raw->ncodec.pdu.payload[0], 0xff);
+
+    pdunet_destroy(route_net);
+}
+
+
+void test_pdunet_pool(void** state)
+{
+    ModelCMock* mock = *state;
+    int         rc = 0;
+    assert_non_null(mock->mi);
+    ModelInstancePrivate* mip = mock->mi->private;
+
+    // Networks are destroyed (via mip->pdunet) by modelc_exit().
+    void*           ncodec = NULL;
+    PduNetworkDesc* net =
+        pdunet_create(mock->mi, ncodec, NULL, NULL, NULL, NULL);
+    SchemaLabel labels[] = {
+        { .name = "name", .value = "Multiplex" },
+        {},
+    };
+    rc = pdunet_parse(net, labels);
+    assert_int_equal(rc, 0);
+    rc = pdunet_configure(net);
+    assert_int_equal(rc, 0);
+    rc = pdunet_transform(net, NULL);
+    assert_int_equal(rc, 0);
+    assert_false(net->lua.installed);
+    vector_push(&mip->pdunet, &net);
+
+    // One network, no pool.
+    rc = pdunet_pool_create(mock->mi);
+    assert_int_equal(rc, 0);
+    assert_null(mip->pdunet_pool);
+
+    // Two networks, pool (annotation pdunet_workers: 2).
+    PduNetworkDesc* route_net =
+        pdunet_create(mock->mi, ncodec, NULL, NULL, NULL, NULL);
+    SchemaLabel route_labels[] = {
+        { .name = "name", .value = "Route" },
+        {},
+    };
+    rc = pdunet_parse(route_net, route_labels);
+    assert_int_equal(rc, 0);
+    rc = pdunet_configure(route_net);
+    assert_int_equal(rc, 0);
+    rc = pdunet_transform(route_net, NULL);
+    assert_int_equal(rc, 0);
+    vector_push(&mip->pdunet, &route_net);
+    rc = pdunet_pool_create(mock->mi);
+    assert_int_equal(rc, 0);
+    assert_non_null(mip->pdunet_pool);
+
+    // Stop the workers.
+    pdunet_pool_destroy(mip->pdunet_pool);
+    mip->pdunet_pool = NULL;
+}
+
+
+static uint32_t _matrix_idx(PduNetworkDesc* net, const char* name)
+{
+    for (uint32_t i = 0; i < vector_len(&net->matrix.signal.name); i++) {
+        const char** n = vector_at(&net->matrix.signal.name, i, NULL);
+        if (strcmp(*n, name) == 0) return i;
+    }
+    assert_string_equal(name, "");  // Signal not in matrix.
+    return 0;
+}
+
+static void _assert_run(
+    Vector* runs, size_t idx, uint32_t signal, uint32_t source, uint32_t count)
+{
+    PduMarshalRun* run = vector_at(runs, idx, NULL);
+    assert_non_null(run);
+    assert_int_equal(run->signal, signal);
+    assert_int_equal(run->source, source);
+    assert_int_equal(run->count, count);
+}
+
+void test_pdunet_marshal_runs(void** state)
+{
+    ModelCMock* mock = *state;
+    assert_non_null(mock->mi);
+
+    PduNetworkDesc* net = pdunet_create(mock->mi, NULL, NULL, NULL, NULL, NULL);
+    struct {
+        uint32_t     id;
+        PduDirection dir;
+        const char*  names[4];
+    } pdus[] = {
+        { 1, PduDirectionTx, { "A", "B", "C", "D" } },
+        { 2, PduDirectionRx, { "E", "F", "G" } },
+    };
+    for (size_t i = 0; i < ARRAY_SIZE(pdus); i++) {
+        PduItem pdu = {
+            .name = "MSM",
+            .id = pdus[i].id,
+            .length = 8,
+            .dir = pdus[i].dir,
+            .signals = vector_make(sizeof(PduSignalItem), 0, NULL),
+        };
+        for (uint16_t j = 0; j < 4 && pdus[i].names[j]; j++) {
+            vector_push(&pdu.signals,
+                &(PduSignalItem){ .name = pdus[i].names[j],
+                    .start_bit = j * 16,
+                    .length_bits = 16,
+                    .factor = 1,
+                    .offset = 0,
+                    .min = NAN,
+                    .max = NAN });
+        }
+        vector_push(&net->pdus, &pdu);
+    }
+    assert_int_equal(pdunet_transform(net, NULL), 0);
+
+    // SignalVector: Tx signals A,B contiguous then C,D after a gap (X), Rx
+    // signals in reverse order of the matrix (G,F,E).
+    const char*  names[] = { "A", "B", "X", "C", "D", "G", "F", "E" };
+    double       scalar[ARRAY_SIZE(names)] = {};
+    SignalVector sv[] = {
+        { .name = "scalar",
+            .alias = "msm",
+            .count = ARRAY_SIZE(names),
+            .signal = names,
+            .scalar = scalar },
+        {},
+    };
+    ModelDesc  model_desc = { .sv = sv };
+    ModelDesc* save_model_desc = mock->mi->model_desc;
+    mock->mi->model_desc = &model_desc;
+    pdunet_build_msm(net, "msm");
+    mock->mi->model_desc = save_model_desc;
+    assert_ptr_equal(net->msm.scalar, scalar);
+
+    // Run boundaries: contiguous in both SignalVector and matrix.
+    uint32_t a = _matrix_idx(net, "A");
+    uint32_t e = _matrix_idx(net, "E");
+    assert_int_equal(_matrix_idx(net, "B"), a + 1);
+    assert_int_equal(_matrix_idx(net, "C"), a + 2);
+    assert_int_equal(_matrix_idx(net, "D"), a + 3);
+    assert_int_equal(vector_len(&net->msm.run_out), 2);
+    _assert_run(&net->msm.run_out, 0, 0, a, 2);
+    _assert_run(&net->msm.run_out, 1, 3, a + 2, 2);
+    assert_int_equal(vector_len(&net->msm.run_in), 3);
+    _assert_run(&net->msm.run_in, 0, 7, e, 1);
+    _assert_run(&net->msm.run_in, 1, 6, e + 1, 1);
+    _assert_run(&net->msm.run_in, 2, 5, e + 2, 1);
+
+    // Tx, range filtering: the Rx range contains no Tx runs.
+    PduRange* tx_range = _find_pdu(net, 1)->matrix.pdu_range;
+    PduRange* rx_range = _find_pdu(net, 2)->matrix.pdu_range;
+    assert_ptr_not_equal(tx_range, rx_range);
+    double* phys = vector_at(&net->matrix.signal.phys, 0, NULL);
+    double  tx[] = { 1, 2, 99, 3, 4 };
+    memcpy(scalar, tx, sizeof(tx));
+    pdunet_tx(net, rx_range, NULL, NULL, 0.0);
+    for (uint32_t i = 0; i < 4; i++) {
+        assert_double_equal(phys[a + i], 0.0, 0.0);
+    }
+    pdunet_tx(net, tx_range, NULL, NULL, 0.0);
+    assert_double_equal(phys[a + 0], 1, 0.0);
+    assert_double_equal(phys[a + 1], 2, 0.0);
+    assert_double_equal(phys[a + 2], 3, 0.0);
+    assert_double_equal(phys[a + 3], 4, 0.0);
+    assert_memory_equal(scalar, tx, sizeof(tx));
+    uint8_t tx_payload[] = { 1, 0, 2, 0, 3, 0, 4, 0 };
+    assert_memory_equal(_find_pdu(net, 1)->ncodec.pdu.payload, tx_payload, 8);
+
+    // Rx, range filtering: the Tx range contains no Rx runs.
+    uint8_t* payload = _find_pdu(net, 2)->ncodec.pdu.payload;
+    memcpy(payload, (uint8_t[]){ 5, 1, 6, 0, 7, 0, 0, 0 }, 8);
+    pdunet_rx(net, tx_range, NULL, NULL);
+    assert_double_equal(scalar[5], 0.0, 0.0);
+    assert_double_equal(scalar[6], 0.0, 0.0);
+    assert_double_equal(scalar[7], 0.0, 0.0);
+    pdunet_rx(net, rx_range, NULL, NULL);
+    assert_double_equal(scalar[7], 261, 0.0); /* E */
+    assert_double_equal(scalar[6], 6, 0.0);   /* F */
+    assert_double_equal(scalar[5], 7, 0.0);   /* G */
+    assert_memory_equal(scalar, tx, sizeof(tx));
+
+    // No range: all runs.
+    scalar[0] = 10;
+    scalar[4] = 40;
+    memcpy(payload, (uint8_t[]){ 8, 0, 9, 0, 10, 0, 0, 0 }, 8);
+    pdunet_tx(net, NULL, NULL, NULL, 0.0005);
+    assert_double_equal(phys[a + 0], 10, 0.0);
+    assert_double_equal(phys[a + 3], 40, 0.0);
+    pdunet_rx(net, NULL, NULL, NULL);
+    assert_double_equal(scalar[7], 8, 0.0);
+    assert_double_equal(scalar[6], 9, 0.0);
+    assert_double_equal(scalar[5], 10, 0.0);
+    assert_double_equal(scalar[2], 99, 0.0);
+
+    pdunet_destroy(net);
+}
+
+
+#define POOL_NET_COUNT 4
+#define POOL_SV_COUNT  6 /* Per network: 3 Tx signals, 3 Rx signals. */
+
+static PduNetworkDesc* _pool_net(
+    ModelInstanceSpec* mi, double* scalar, uint32_t sv_offset)
+{
+    PduNetworkDesc* net = pdunet_create(mi, NULL, NULL, NULL, NULL, NULL);
+    PduSignalItem   signals[] = {
+        { .name = "A", .start_bit = 0, .length_bits = 16, .factor = 0.5,
+              .offset = -10, .min = NAN, .max = NAN },
+        { .name = "B", .start_bit = 16, .length_bits = 16, .is_signed = true,
+              .factor = 0.1, .offset = 0, .min = -100, .max = 100 },
+        { .name = "C", .start_bit = 32, .length_bits = 8, .factor = 2,
+              .offset = 1, .min = NAN, .max = NAN },
+    };
+    for (uint32_t id = 1; id <= 2; id++) {
+        PduItem pdu = {
+            .name = "POOL",
+            .id = id,
+            .length = 8,
+            .dir = (id == 1) ? PduDirectionTx : PduDirectionRx,
+            .signals = vector_make(sizeof(PduSignalItem), 0, NULL),
+        };
+        for (size_t i = 0; i < ARRAY_SIZE(signals); i++) {
+            vector_push(&pdu.signals, &signals[i]);
+        }
+        vector_push(&net->pdus, &pdu);
+    }
+    assert_int_equal(pdunet_transform(net, NULL), 0);
+
+    // Marshal runs: Tx signals from scalar[sv_offset + 0..2], Rx signals to
+    // scalar[sv_offset + 3..5].
+    PduRange* tx = _find_pdu(net, 1)->matrix.pdu_range;
+    PduRange* rx = _find_pdu(net, 2)->matrix.pdu_range;
+    net->msm.scalar = scalar;
+    net->msm.run_in = vector_make(sizeof(PduMarshalRun), 1, NULL);
+    net->msm.run_out = vector_make(sizeof(PduMarshalRun), 1, NULL);
+    vector_push(&net->msm.run_out,
+        &(PduMarshalRun){
+            .signal = sv_offset, .source = tx->offset, .count = 3 });
+    vector_push(&net->msm.run_in,
+        &(PduMarshalRun){
+            .signal = sv_offset + 3, .source = rx->offset, .count = 3 });
+    return net;
+}
+
+static void _assert_pool_net_equal(PduNetworkDesc* a, PduNetworkDesc* b)
+{
+    size_t count = vector_len(&a->matrix.signal.raw);
+    assert_int_equal(count, vector_len(&b->matrix.signal.raw));
+    assert_memory_equal(vector_at(&a->matrix.signal.raw, 0, NULL),
+        vector_at(&b->matrix.signal.raw, 0, NULL), count * sizeof(uint64_t));
+    assert_memory_equal(vector_at(&a->matrix.signal.phys, 0, NULL),
+        vector_at(&b->matrix.signal.phys, 0, NULL), count * sizeof(double));
+    for (uint32_t id = 1; id <= 2; id++) {
+        PduObject* o_a = _find_pdu(a, id);
+        PduObject* o_b = _find_pdu(b, id);
+        assert_memory_equal(o_a->ncodec.pdu.payload, o_b->ncodec.pdu.payload,
+            o_a->pdu->length);
+        assert_int_equal(o_a->needs_tx, o_b->needs_tx);
+        assert_int_equal(o_a->changed, o_b->changed);
+    }
+}
+
+void test_pdunet_pool_dispatch(void** state)
+{
+    ModelCMock* mock = *state;
+    assert_non_null(mock->mi);
+    ModelInstancePrivate* mip = mock->mi->private;
+
+    // Two identical sets of networks, each mapped to its own SignalVector
+    // scalars: one set is processed sequentially, the other by the pool.
+    double          sv_seq[POOL_NET_COUNT * POOL_SV_COUNT] = {};
+    double          sv_pool[POOL_NET_COUNT * POOL_SV_COUNT] = {};
+    PduNetworkDesc* seq[POOL_NET_COUNT];
+    PduNetworkDesc* pool[POOL_NET_COUNT];
+    for (uint32_t i = 0; i < POOL_NET_COUNT; i++) {
+        seq[i] = _pool_net(mock->mi, sv_seq, i * POOL_SV_COUNT);
+        pool[i] = _pool_net(mock->mi, sv_pool, i * POOL_SV_COUNT);
+        vector_push(&mip->pdunet, &pool[i]);  // modelc_exit() will destroy.
+    }
+    assert_int_equal(pdunet_pool_create(mock->mi), 0);
+    assert_non_null(mip->pdunet_pool);
+
+    for (uint32_t step = 0; step < 4; step++) {
+        double model_time = step * 0.0005;
+
+        // Tx: SignalVector -> PDU payload.
+        for (uint32_t i = 0; i < POOL_NET_COUNT; i++) {
+            for (uint32_t j = 0; j < 3; j++) {
+                double v = step * 10.0 + i * 3.0 + j;
+                sv_seq[i * POOL_SV_COUNT + j] = v;
+                sv_pool[i * POOL_SV_COUNT + j] = v;
+            }
+            pdunet_tx(seq[i], NULL, NULL, NULL, model_time);
+        }
+        pdunet_pool_tx(mip->pdunet_pool, model_time);
+        for (uint32_t i = 0; i < POOL_NET_COUNT; i++) {
+            _assert_pool_net_equal(seq[i], pool[i]);
+        }
+        assert_memory_equal(sv_seq, sv_pool, sizeof(sv_seq));
+
+        // Rx: PDU payload -> SignalVector.
+        for (uint32_t i = 0; i < POOL_NET_COUNT; i++) {
+            uint8_t* p_seq = _find_pdu(seq[i], 2)->ncodec.pdu.payload;
+            uint8_t* p_pool = _find_pdu(pool[i], 2)->ncodec.pdu.payload;
+            for (uint32_t k = 0; k < 8; k++) {
+                p_seq[k] = p_pool[k] = (uint8_t)(step * 16 + i * 4 + k + 1);
+            }
+            pdunet_rx(seq[i], NULL, NULL, NULL);
+        }
+        pdunet_pool_rx(mip->pdunet_pool);
+        for (uint32_t i = 0; i < POOL_NET_COUNT; i++) {
+            _assert_pool_net_equal(seq[i], pool[i]);
+            // Rx signal A: raw = payload[0..1] (little endian).
+            double a = sv_pool[i * POOL_SV_COUNT + 3];
+            uint8_t b0 = (uint8_t)(step * 16 + i * 4 + 1);
+            assert_double_equal(a, (b0 + ((b0 + 1) << 8)) * 0.5 - 10, 0.0);
+        }
+        assert_memory_equal(sv_seq, sv_pool, sizeof(sv_seq));
+    }
+
+    for (uint32_t i = 0; i < POOL_NET_COUNT; i++) {
+        pdunet_destroy(seq[i]);
+    }
+}
+
+
+static MPduItem* _find_mpdu(PduObject* c, uint32_t id)
+{
+    for (size_t i = 0; i < vector_len(&c->container.pdu_list); i++) {
+        MPduItem* pi = vector_at(&c->container.pdu_list, i, NULL);
+        if (pi->id == id) return pi;
+    }
+    return NULL;
+}
+
+void test_pdunet_container_static(void** state)
+{
+    ModelCMock* mock = *state;
+    int         rc = 0;
+    assert_non_null(mock->mi);
+
+    void*           ncodec = NULL;
+    PduNetworkDesc* net =
+        pdunet_create(mock->mi, ncodec, NULL, NULL, NULL, NULL);
+    mock->net = net;  // Teardown will destroy.
+
+    // Static containers (Tx and Rx), I-PDU 503 exceeds the layout.
+    PduItem pdus[] = {
+        { .id = 500, .length = 8, .container.header = HeaderFormatStatic },
+        { .id = 501, .length = 2, .container = { .id = 500, .priority = 1 } },
+        { .id = 502, .length = 4, .container = { .id = 500, .priority = 0 } },
+        { .id = 503, .length = 4, .container = { .id = 500, .priority = 2 } },
+    };
+    for (PduDirection dir = PduDirectionRx; dir <= PduDirectionTx; dir++) {
+        for (size_t i = 0; i < ARRAY_SIZE(pdus); i++) {
+            PduItem pdu = pdus[i];
+            pdu.name = "STATIC";
+            pdu.dir = dir;
+            vector_push(&net->pdus, &pdu);
+        }
+    }
+    rc = pdunet_transform(net, NULL);
+    assert_int_equal(rc, 0);
+    PduObject* c_rx = NULL;
+    PduObject* c_tx = NULL;
+    for (size_t i = 0; i < vector_len(&net->matrix.pdu); i++) {
+        PduObject* o = vector_at(&net->matrix.pdu, i, NULL);
+        if (o->pdu->id != 500) continue;
+        if (o->pdu->dir == PduDirectionRx) c_rx = o;
+        if (o->pdu->dir == PduDirectionTx) c_tx = o;
+    }
+    assert_non_null(c_rx);
+    assert_non_null(c_tx);
+
+    // Layout (by priority).
+    MPduItem* pi_501 = _find_mpdu(c_tx, 501);
+    MPduItem* pi_502 = _find_mpdu(c_tx, 502);
+    MPduItem* pi_503 = _find_mpdu(c_tx, 503);
+    assert_int_equal(pi_502->offset, 0);
+    assert_int_equal(pi_501->offset, 4);
+    assert_int_equal(pi_503->offset, PDUNET_STATIC_NONE);
+
+    // Tx, only the I-PDU which needs Tx is mapped, others retain content.
+    uint8_t* payload = c_tx->ncodec.pdu.payload;
+    memset(payload, 0xaa, 8);
+    memcpy(pi_501->pdu->ncodec.pdu.payload, (uint8_t[]){ 0x11, 0x22 }, 2);
+    pi_501->pdu->needs_tx = true;
+    pi_503->pdu->needs_tx = true;
+    c_tx->needs_tx = true;
+    pdunet_visit_container_mapto(net, c_tx, NULL);
+    uint8_t expect_tx[8] = { 0xaa, 0xaa, 0xaa, 0xaa, 0x11, 0x22, 0xaa, 0xaa };
+    assert_memory_equal(payload, expect_tx, 8);
+    assert_true(c_tx->needs_tx);
+    assert_false(pi_501->pdu->needs_tx);
+
+    // Tx, nothing to map (I-PDU 503 is not in the layout).
+    pdunet_visit_container_mapto(net, c_tx, NULL);
+    assert_false(c_tx->needs_tx);
+
+    // Rx, each I-PDU is copied from its offset.
+    uint8_t rx[8] = { 0x01, 0x02, 0x03, 0x04, 0x11, 0x22, 0x00, 0x00 };
+    memcpy(c_rx->ncodec.pdu.payload, rx, 8);
+    c_rx->update_signals = true;
+    pdunet_visit_container_mapfrom(net, c_rx, NULL);
+    pi_501 = _find_mpdu(c_rx, 501);
+    pi_502 = _find_mpdu(c_rx, 502);
+    assert_memory_equal(pi_502->pdu->ncodec.pdu.payload, rx, 4);
+    assert_memory_equal(pi_501->pdu->ncodec.pdu.payload, rx + 4, 2);
+    assert_int_equal(pi_501->pdu->route.rx_count, 1);
+    assert_int_equal(_find_mpdu(c_rx, 503)->pdu->route.rx_count, 0);
+}
+
+
+void test_pdunet_index_order(void** state)
+{
+    UNUSED(state);
+
+    /* Items with equal ids are ordered by idx. */
+    Vector       index = pdunet_index_make(8);
+    PduIndexItem items[] = {
+        { .id = 7, .idx = 5 },
+        { .id = 3, .idx = 4 },
+        { .id = 7, .idx = 1 },
+        { .id = 3, .idx = 9 },
+        { .id = 7, .idx = 3 },
+        { .id = 3, .idx = 0 },
+    };
+    for (size_t i = 0; i < ARRAY_SIZE(items); i++) {
+        vector_push(&index, &items[i]);
+    }
+    vector_sort(&index);
+
+    size_t        count = 0;
+    PduIndexItem* item = pdunet_index_find(&index, 3, &count);
+    assert_non_null(item);
+    assert_int_equal(count, 3);
+    assert_int_equal(item[0].idx, 0);
+    assert_int_equal(item[1].idx, 4);
+    assert_int_equal(item[2].idx, 9);
+    item = pdunet_index_find(&index, 7, &count);
+    assert_non_null(item);
+    assert_int_equal(count, 3);
+    assert_int_equal(item[0].idx, 1);
+    assert_int_equal(item[1].idx, 3);
+    assert_int_equal(item[2].idx, 5);
+
+    vector_reset(&index);
+}
+
+
+static void _calculate_range(PduNetworkDesc* net, PduRange* r, bool scalar)
+{
+    uint8_t* linear = vector_at(&net->matrix.signal.linear, r->offset, NULL);
+    uint8_t  save_linear[16] = {};
+    Vector   save_list = r->scalar_list;
+    assert_true(r->length <= ARRAY_SIZE(save_linear));
+
+    if (scalar) {
+        /* Force all signals through the scalar path. */
+        memcpy(save_linear, linear, r->length);
+        memset(linear, 0, r->length);
+        r->scalar_list = vector_make(sizeof(size_t), r->length, NULL);
+        for (size_t j = 0; j < r->length; j++) {
+            vector_push(&r->scalar_list, &j);
+        }
+    }
+    pdunet_pdu_calculate_linear_range(net, r);
+    if (scalar) {
+        memcpy(linear, save_linear, r->length);
+        vector_reset(&r->scalar_list);
+        r->scalar_list = save_list;
+    }
+}
+
+void test_pdunet_linear_scalar(void** state)
+{
+    ModelCMock* mock = *state;
+    int         rc = 0;
+    assert_non_null(mock->mi);
+
+    void*           ncodec = NULL;
+    PduNetworkDesc* net =
+        pdunet_create(mock->mi, ncodec, NULL, NULL, NULL, NULL);
+    mock->net = net;  // Teardown will destroy.
+
+    // Signals: offset/factor, min/max clamping and NaN factor/offset.
+    PduSignalItem signals[] = {
+        { .name = "A", .start_bit = 0, .length_bits = 16, .factor = 0.5,
+            .offset = -10, .min = NAN, .max = NAN },
+        { .name = "B", .start_bit = 16, .length_bits = 16, .is_signed = true,
+            .factor = 0.1, .offset = 0, .min = -100, .max = 100 },
+        { .name = "C", .start_bit = 32, .length_bits = 8, .factor = 2,
+            .offset = 1, .min = 5, .max = 50 },
+        { .name = "D", .start_bit = 40, .length_bits = 8, .factor = NAN,
+            .offset = 0, .min = NAN, .max = NAN },
+        { .name = "E", .start_bit = 48, .length_bits = 8, .factor = 1,
+            .offset = NAN, .min = NAN, .max = NAN },
+        { .name = "F", .start_bit = 64, .length_bits = 32, .is_signed = true,
+            .factor = 1, .offset = 0, .min = NAN, .max = NAN },
+    };
+    for (uint32_t id = 1; id <= 2; id++) {
+        PduItem pdu = {
+            .name = "LINEAR",
+            .id = id,
+            .length = 16,
+            .dir = (id == 1) ? PduDirectionTx : PduDirectionRx,
+            .signals = vector_make(sizeof(PduSignalItem), 0, NULL),
+        };
+        for (size_t i = 0; i < ARRAY_SIZE(signals); i++) {
+            vector_push(&pdu.signals, &signals[i]);
+        }
+        vector_push(&net->pdus, &pdu);
+    }
+    rc = pdunet_transform(net, NULL);
+    assert_int_equal(rc, 0);
+
+    // Signals with NaN factor/offset are in the scalar partition.
+    PduRange* tx = _find_pdu(net, 1)->matrix.pdu_range;
+    PduRange* rx = _find_pdu(net, 2)->matrix.pdu_range;
+    assert_non_null(tx);
+    assert_non_null(rx);
+    assert_ptr_not_equal(tx, rx);
+    assert_int_equal(tx->length, ARRAY_SIZE(signals));
+    assert_int_equal(rx->length, ARRAY_SIZE(signals));
+    assert_int_equal(vector_len(&tx->scalar_list), 2);
+    assert_int_equal(vector_len(&rx->scalar_list), 2);
+
+    // Tx: phys -> raw.
+    // clang-format off
+    uint64_t raw_init = 0xA5A5A5A5A5A5A5A5;
+    struct {
+        double   phys[6];
+        uint64_t raw[6];
+    } tx_checks[] = {
+        { { 20, 50.5, 30, 7, 3, -123456 },
+          { 60, 505, 14, raw_init, raw_init, (uint64_t)-123456 } },
+        { { -10, -100, 5, 1, 1, 0 },
+          { 0, (uint64_t)-1000, 2, raw_init, raw_init, 0 } },
+        { { 0, 150, 4, 0, 0, 2147483647 },   /* B max, C min. */
+          { 20, raw_init, raw_init, raw_init, raw_init, 2147483647 } },
+        { { 1000, -100.5, 51, 0, 0, -1 },    /* B min, C max. */
+          { 2020, raw_init, raw_init, raw_init, raw_init, (uint64_t)-1 } },
+    };
+    // clang-format on
+    double*   phys = vector_at(&net->matrix.signal.phys, tx->offset, NULL);
+    uint64_t* raw = vector_at(&net->matrix.signal.raw, tx->offset, NULL);
+    for (size_t i = 0; i < ARRAY_SIZE(tx_checks); i++) {
+        uint64_t linear_raw[6];
+        double   linear_phys[6];
+        for (size_t j = 0; j < 6; j++) {
+            phys[j] = tx_checks[i].phys[j];
+            raw[j] = raw_init;
+        }
+        _calculate_range(net, tx, false);
+        memcpy(linear_raw, raw, sizeof(linear_raw));
+        memcpy(linear_phys, phys, sizeof(linear_phys));
+        for (size_t j = 0; j < 6; j++) {
+            phys[j] = tx_checks[i].phys[j];
+            raw[j] = raw_init;
+        }
+        _calculate_range(net, tx, true);
+        assert_memory_equal(linear_raw, raw, sizeof(linear_raw));
+        assert_memory_equal(linear_phys, phys, sizeof(linear_phys));
+        for (size_t j = 0; j < 6; j++) {
+            assert_int_equal(raw[j], tx_checks[i].raw[j]);
+        }
+    }
+
+    // Rx: raw -> phys.
+    // clang-format off
+    double phys_init = -999.25;
+    struct {
+        uint64_t raw[6];
+        double   phys[6];
+    } rx_checks[] = {
+        { { 60, 505, 14, 7, 3, (uint64_t)-123456 },
+          { 20, 50.5, 29, phys_init, phys_init, -123456 } },
+        { { 0, (uint64_t)-1000, 2, 1, 1, 0 },
+          { -10, -100, 5, phys_init, phys_init, 0 } },
+        { { 65535, 1001, 1, 0, 0, 2147483647 },    /* B max, C min. */
+          { 32757.5, phys_init, phys_init, phys_init, phys_init,
+            2147483647 } },
+        { { 20, (uint64_t)-1001, 25, 0, 0, (uint64_t)-1 }, /* B min, C max. */
+          { 0, phys_init, phys_init, phys_init, phys_init, -1 } },
+    };
+    // clang-format on
+    phys = vector_at(&net->matrix.signal.phys, rx->offset, NULL);
+    raw = vector_at(&net->matrix.signal.raw, rx->offset, NULL);
+    for (size_t i = 0; i < ARRAY_SIZE(rx_checks); i++) {
+        uint64_t linear_raw[6];
+        double   linear_phys[6];
+        for (size_t j = 0; j < 6; j++) {
+            raw[j] = rx_checks[i].raw[j];
+            phys[j] = phys_init;
+        }
+        _calculate_range(net, rx, false);
+        memcpy(linear_raw, raw, sizeof(linear_raw));
+        memcpy(linear_phys, phys, sizeof(linear_phys));
+        for (size_t j = 0; j < 6; j++) {
+            raw[j] = rx_checks[i].raw[j];
+            phys[j] = phys_init;
+        }
+        _calculate_range(net, rx, true);
+        assert_memory_equal(linear_raw, raw, sizeof(linear_raw));
+        assert_memory_equal(linear_phys, phys, sizeof(linear_phys));
+        for (size_t j = 0; j < 6; j++) {
+            assert_double_equal(phys[j], rx_checks[i].phys[j], 1e-9);
+        }
+    }
+}
+
+
+#define INDEX_PDU_COUNT 1000
+
+void test_pdunet_index_lookup(void** state)
+{
+    ModelCMock* mock = *state;
+    int         rc = 0;
+    assert_non_null(mock->mi);
+
+    void*           ncodec = NULL;
+    PduNetworkDesc* net =
+        pdunet_create(mock->mi, ncodec, NULL, NULL, NULL, NULL);
+    mock->net = net;  // Teardown will destroy.
+
+    // Network with 1k PDUs (reverse id order, mixed Rx/Tx).
+    for (size_t i = 0; i < INDEX_PDU_COUNT; i++) {
+        PduItem pdu = {
+            .name = "INDEX",
+            .id = 0x100 + (INDEX_PDU_COUNT - i),
+            .length = 8,
+            .dir = (i % 4) ? PduDirectionRx : PduDirectionTx,
+        };
+        vector_push(&net->pdus, &pdu);
+    }
+    rc = pdunet_transform(net, NULL);
+    assert_int_equal(rc, 0);
+    assert_int_equal(vector_len(&net->matrix.pdu), INDEX_PDU_COUNT);
+    assert_int_equal(vector_len(&net->matrix.rx_index), 750);
+
+    // Linear search (expected count of Rx PDUs for each id).
+    size_t found_linear = 0;
+    for (size_t i = 0; i < vector_len(&net->matrix.pdu); i++) {
+        PduObject* o = vector_at(&net->matrix.pdu, i, NULL);
+        if (o->pdu->dir != PduDirectionRx) continue;
+        found_linear++;
+    }
+
+    // Index search, every id (and the id above the range).
+    size_t found_index = 0;
+    for (uint32_t id = 0x100; id <= 0x100 + INDEX_PDU_COUNT + 1; id++) {
+        size_t        count = 0;
+        PduIndexItem* index =
+            pdunet_index_find(&net->matrix.rx_index, id, &count);
+        for (size_t i = 0; i < count; i++) {
+            PduObject* o = vector_at(&net->matrix.pdu, index[i].idx, NULL);
+            assert_int_equal(o->pdu->id, id);
+            assert_int_equal(o->pdu->dir, PduDirectionRx);
+            found_index++;
+        }
+    }
+    assert_int_equal(found_linear, 750);
+    assert_int_equal(found_index, found_linear);
+
+    // Unknown ids.
+    size_t count = 99;
+    assert_null(pdunet_index_find(&net->matrix.rx_index, 0x42, &count));
+    assert_int_equal(count, 0);
+}
+
+
 int run_model_pdu_tests(void)
 {
     void* s = test_setup;
     void* sl = test_setup_lua;
     void* sc = test_setup_container;
     void* ss = test_setup_secured;
+    void* se = test_setup_encoding;
     void* t = test_teardown;
 
     const struct CMUnitTest tests[] = {
@@ -1495,10 +3004,27 @@ int run_model_pdu_tests(void)
         cmocka_unit_test_setup_teardown(test_pdunet_config, sl, t),
         cmocka_unit_test_setup_teardown(test_pdunet_lua_tx, sl, t),
         cmocka_unit_test_setup_teardown(test_pdunet_lua_rx, sl, t),
+        cmocka_unit_test_setup_teardown(test_pdunet_lua_range, sl, t),
         cmocka_unit_test_setup_teardown(test_pdunet_container_tx, sc, t),
         cmocka_unit_test_setup_teardown(test_pdunet_container_rx, sc, t),
+        cmocka_unit_test_setup_teardown(test_pdunet_container_static, s, t),
         cmocka_unit_test_setup_teardown(test_pdunet_secured_pdu_tx, ss, t),
         cmocka_unit_test_setup_teardown(test_pdunet_secured_pdu_rx, ss, t),
+        cmocka_unit_test_setup_teardown(test_pdunet_schedule_queue, s, t),
+        cmocka_unit_test_setup_teardown(test_pdunet_schedule_idle, s, t),
+        cmocka_unit_test_setup_teardown(test_pdunet_range, s, t),
+        cmocka_unit_test_setup_teardown(test_pdunet_cache, s, t),
+        cmocka_unit_test_setup_teardown(test_pdunet_e2e, s, t),
+        cmocka_unit_test(test_pdunet_index_order),
+        cmocka_unit_test_setup_teardown(test_pdunet_linear_scalar, s, t),
+        cmocka_unit_test_setup_teardown(test_pdunet_index_lookup, s, t),
+        cmocka_unit_test_setup_teardown(
+            test_pdunet_pack_byte_order_signed, se, t),
+        cmocka_unit_test_setup_teardown(test_pdunet_multiplex, se, t),
+        cmocka_unit_test_setup_teardown(test_pdunet_route, se, t),
+        cmocka_unit_test_setup_teardown(test_pdunet_marshal_runs, s, t),
+        cmocka_unit_test_setup_teardown(test_pdunet_pool, se, t),
+        cmocka_unit_test_setup_teardown(test_pdunet_pool_dispatch, se, t),
     };
 
     return cmocka_run_group_tests_name("PDU Network", tests, NULL, NULL);
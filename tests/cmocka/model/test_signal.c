@@ -311,7 +311,7 @@ void test_signal__binary(void** state)
         assert_non_null(sv->binary[i]);
         assert_string_equal((char*)sv->binary[i], (char*)test_val);
         assert_int_equal(sv->length[i], test_val_len);
-        assert_int_equal(sv->buffer_size[i], test_val_len);
+        assert_int_equal(sv->buffer_size[i], 64); /* Minimum size. */
         signal_read(sv, i, &buffer, &buffer_len);
         assert_string_equal((char*)buffer, (char*)test_val);
         assert_int_equal(buffer_len, test_val_len);
@@ -324,13 +324,13 @@ void test_signal__binary(void** state)
         assert_true(sv->reset_called[i]);
         assert_non_null(sv->binary[i]);
         assert_int_equal(sv->length[i], 0);
-        assert_int_equal(sv->buffer_size[i], test_val_len);
+        assert_int_equal(sv->buffer_size[i], 64); /* Minimum size. */
         /* Append to the value with embedded NULL. */
         test_val[5] = '\0';
         signal_append(sv, i, test_val, test_val_len);
         assert_non_null(sv->binary[i]);
         assert_int_equal(sv->length[i], test_val_len);
-        assert_int_equal(sv->buffer_size[i], test_val_len);
+        assert_int_equal(sv->buffer_size[i], 64); /* Minimum size. */
         signal_read(sv, i, &buffer, &buffer_len);
         assert_int_equal(buffer_len, test_val_len);
         /* Release the value. */
@@ -344,6 +344,64 @@ void test_signal__binary(void** state)
 }
 
 
+void test_signal__binary_reserve(void** state)
+{
+    ModelCMock* mock = *state;
+
+    /* Use the "binary" signal vector. */
+    SignalVector* sv = mock->mi->model_desc->sv;
+    while (sv && sv->name) {
+        if (strcmp(sv->name, "binary") == 0) break;
+        /* Next signal vector. */
+        sv++;
+    }
+    assert_int_equal(sv->is_binary, true);
+
+    /* Reserve, write in place, then commit. */
+    uint8_t* data = NULL;
+    signal_reset(sv, 0);
+    assert_int_equal(signal_reserve(sv, 0, 100, &data), 0);
+    assert_non_null(data);
+    assert_int_equal(sv->length[0], 0);
+    assert_int_equal(sv->buffer_size[0], 128);
+    memcpy(data, "hello", 5);
+    assert_int_equal(signal_commit(sv, 0, 5), 0);
+    assert_int_equal(sv->length[0], 5);
+    signal_append(sv, 0, (uint8_t*)" world", 7);
+    assert_int_equal(sv->length[0], 12);
+    assert_string_equal((char*)sv->binary[0], "hello world");
+    assert_int_equal(sv->buffer_size[0], 128);
+
+    /* Buffer is retained by reset, and grows geometrically. */
+    void* buffer = sv->binary[0];
+    signal_reset(sv, 0);
+    assert_ptr_equal(sv->binary[0], buffer);
+    assert_int_equal(signal_reserve(sv, 0, 129, &data), 0);
+    assert_int_equal(sv->buffer_size[0], 256);
+    assert_int_equal(signal_commit(sv, 0, 257), -EINVAL);
+    assert_int_equal(sv->length[0], 0);
+
+    /* Oversized reserve, the length would exceed UINT32_MAX. */
+    signal_append(sv, 0, (uint8_t*)"hello", 5);
+    data = NULL;
+    assert_int_equal(signal_reserve(sv, 0, UINT32_MAX - 4, &data), -ENOMEM);
+    assert_null(data);
+    assert_int_equal(sv->length[0], 5);
+    assert_int_equal(sv->buffer_size[0], 256);
+    if (sizeof(size_t) > sizeof(uint32_t)) {
+        assert_int_equal(signal_reserve(sv, 0, (size_t)UINT32_MAX + 1, &data),
+            -ENOMEM);
+    }
+    assert_int_equal(sv->length[0], 5);
+
+    /* Bad arguments. */
+    assert_int_equal(signal_reserve(sv, 0, 10, NULL), -EINVAL);
+    assert_int_equal(signal_reserve(sv, sv->count, 10, &data), -EINVAL);
+    assert_int_equal(signal_commit(sv, sv->count, 0), -EINVAL);
+    signal_release(sv, 0);
+}
+
+
 void test_signal__annotations(void** state)
 {
     ModelCMock* mock = *state;
@@ -574,6 +632,7 @@ int run_signal_tests(void)
         cmocka_unit_test_setup_teardown(test_signal__index, s, t),
         cmocka_unit_test_setup_teardown(test_signal__scalar, s, t),
         cmocka_unit_test_setup_teardown(test_signal__binary, s, t),
+        cmocka_unit_test_setup_teardown(test_signal__binary_reserve, s, t),
         cmocka_unit_test_setup_teardown(test_signal__annotations, s, t),
         cmocka_unit_test_setup_teardown(test_signal__group_annotations, s, t),
         cmocka_unit_test_setup_teardown(test_signal__binary_echo, s, t),
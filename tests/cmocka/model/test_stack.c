@@ -94,6 +94,79 @@ void test_stack__sim_spec(void** state)
 }
 
 
+static int test_setup_simmock(void** state)
+{
+    UNUSED(state);
+    return 0;
+}
+
+
+static int test_teardown_simmock(void** state)
+{
+    SimMock* mock = *state;
+
+    simmock_exit(mock, true);
+    simmock_free(mock);
+
+    return 0;
+}
+
+
+static double _rate_model_time[10];
+static double _rate_stop_time[10];
+static uint   _rate_calls;
+
+static int _rate_step(ModelDesc* model, double* model_time, double stop_time)
+{
+    if (_rate_calls < ARRAY_SIZE(_rate_model_time)) {
+        _rate_model_time[_rate_calls] = *model_time;
+        _rate_stop_time[_rate_calls] = stop_time;
+    }
+    _rate_calls++;
+    model->sv->scalar[0] += 1;
+    *model_time = stop_time;
+    return 0;
+}
+
+
+void test_stack__rate(void** state)
+{
+    const char* inst_names[] = {
+        "rate",
+    };
+    char* argv[] = {
+        (char*)"test_rate",
+        (char*)"--name=rate",
+        (char*)"--logger=5",  // 1=debug, 5=QUIET (commit with 5!)
+        (char*)"resources/model/rate.yaml",
+    };
+    SimMock* mock = *state = simmock_alloc(inst_names, ARRAY_SIZE(inst_names));
+    simmock_configure(mock, argv, ARRAY_SIZE(argv), ARRAY_SIZE(inst_names));
+    ModelMock* model = simmock_find_model(mock, "rate");
+    model->vtable.step = _rate_step;
+    model->mi = modelc_get_model_instance(&mock->sim, model->name);
+    mock->doc_list = mock->model->mi->yaml_doc_list;
+    simmock_setup(mock, "scalar", NULL);
+    _rate_calls = 0;
+
+    /* Model Function step size from the instance annotation. */
+    ModelFunction* mf = controller_get_model_function(model->mi, "model_step");
+    assert_non_null(mf);
+    assert_double_equal(mf->step_size, 0.002, 0.0);
+
+    /* Simulation step size is 0.0005, the function is due every 4 steps. */
+    for (uint i = 0; i < 12; i++) {
+        assert_int_equal(simmock_step(mock, true), 0);
+        assert_int_equal(_rate_calls, (i + 1) / 4);
+    }
+    assert_double_equal(mock->sv_signal->scalar[0], 3.0, 0.0);
+    for (uint i = 0; i < _rate_calls; i++) {
+        assert_double_equal(_rate_model_time[i], i * 0.002, 1e-9);
+        assert_double_equal(_rate_stop_time[i], (i + 1) * 0.002, 1e-9);
+    }
+}
+
+
 int run_stack_tests(void)
 {
     void* s = test_setup;
@@ -102,6 +175,8 @@ int run_stack_tests(void)
     const struct CMUnitTest tests[] = {
         cmocka_unit_test_setup_teardown(test_stack__sequential_cosim, s, t),
         cmocka_unit_test_setup_teardown(test_stack__sim_spec, s, t),
+        cmocka_unit_test_setup_teardown(
+            test_stack__rate, test_setup_simmock, test_teardown_simmock),
     };
 
     return cmocka_run_group_tests_name("STACK", tests, NULL, NULL);
@@ -0,0 +1,164 @@
+// Copyright 2026 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <dse/testing.h>
+#include <dse/modelc/controller/model_private.h>
+
+
+#define UNUSED(x) ((void)x)
+
+#define PCAP_FILE "trace_pcap.pcapng"
+
+
+static uint32_t _u32(const uint8_t* p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+
+static uint16_t _u16(const uint8_t* p)
+{
+    uint16_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+
+static size_t _read_file(const char* path, uint8_t* buffer, size_t size)
+{
+    FILE* f = fopen(path, "rb");
+    assert_non_null(f);
+    size_t len = fread(buffer, 1, size, f);
+    fclose(f);
+    return len;
+}
+
+
+void test_trace_pcap__blocks(void** state)
+{
+    UNUSED(state);
+
+    /* Two interfaces share the capture file. */
+    int can_if = ncodec_pcap_open(PCAP_FILE, 227, "can0");
+    int fr_if = ncodec_pcap_open(PCAP_FILE, 210, NULL);
+    assert_int_equal(can_if, 0);
+    assert_int_equal(fr_if, 1);
+
+    uint8_t header[8] = { 0x42, 0, 0, 0, 3 };
+    uint8_t data[3] = { 0xAA, 0xBB, 0xCC };
+    ncodec_pcap_write(can_if, 1.5, true, header, sizeof(header), data, 3);
+    ncodec_pcap_write(fr_if, 2.0, false, header, 4, NULL, 0);
+    ncodec_pcap_write(-1, 2.0, false, header, 4, NULL, 0); /* Ignored. */
+    ncodec_pcap_close();
+    ncodec_pcap_close();
+    /* Closed, frames are ignored. */
+    ncodec_pcap_write(can_if, 3.0, true, header, sizeof(header), data, 3);
+
+    uint8_t  b[512] = {};
+    size_t   len = _read_file(PCAP_FILE, b, sizeof(b));
+    uint8_t* p = b;
+    assert_int_equal(len, 28 + 32 + 24 + 56 + 48);
+
+    /* Section Header Block. */
+    assert_int_equal(_u32(p + 0), 0x0A0D0D0A);
+    assert_int_equal(_u32(p + 4), 28);
+    assert_int_equal(_u32(p + 8), 0x1A2B3C4D);
+    assert_int_equal(_u16(p + 12), 1);
+    assert_int_equal(_u16(p + 14), 0);
+    assert_int_equal(_u32(p + 16), UINT32_MAX);
+    assert_int_equal(_u32(p + 20), UINT32_MAX);
+    assert_int_equal(_u32(p + 24), 28);
+    p += 28;
+
+    /* Interface Description Block, with if_name option. */
+    assert_int_equal(_u32(p + 0), 0x00000001);
+    assert_int_equal(_u32(p + 4), 32);
+    assert_int_equal(_u16(p + 8), 227);
+    assert_int_equal(_u16(p + 10), 0);
+    assert_int_equal(_u32(p + 12), 0);
+    assert_int_equal(_u16(p + 16), 2);
+    assert_int_equal(_u16(p + 18), 4);
+    assert_memory_equal(p + 20, "can0", 4);
+    assert_int_equal(_u32(p + 24), 0);
+    assert_int_equal(_u32(p + 28), 32);
+    p += 32;
+
+    /* Interface Description Block, no options. */
+    assert_int_equal(_u32(p + 0), 0x00000001);
+    assert_int_equal(_u32(p + 4), 24);
+    assert_int_equal(_u16(p + 8), 210);
+    assert_int_equal(_u32(p + 16), 0);
+    assert_int_equal(_u32(p + 20), 24);
+    p += 24;
+
+    /* Enhanced Packet Block, Rx, data padded to 4 bytes. */
+    assert_int_equal(_u32(p + 0), 0x00000006);
+    assert_int_equal(_u32(p + 4), 56);
+    assert_int_equal(_u32(p + 8), can_if);
+    assert_int_equal(_u32(p + 12), 0);
+    assert_int_equal(_u32(p + 16), 1500000);
+    assert_int_equal(_u32(p + 20), 11);
+    assert_int_equal(_u32(p + 24), 11);
+    assert_memory_equal(p + 28, header, sizeof(header));
+    assert_memory_equal(p + 36, data, sizeof(data));
+    assert_int_equal(p[39], 0);
+    assert_int_equal(_u16(p + 40), 2);
+    assert_int_equal(_u16(p + 42), 4);
+    assert_int_equal(_u32(p + 44), 0x1);
+    assert_int_equal(_u32(p + 48), 0);
+    assert_int_equal(_u32(p + 52), 56);
+    p += 56;
+
+    /* Enhanced Packet Block, Tx, header only. */
+    assert_int_equal(_u32(p + 0), 0x00000006);
+    assert_int_equal(_u32(p + 4), 48);
+    assert_int_equal(_u32(p + 8), fr_if);
+    assert_int_equal(_u32(p + 16), 2000000);
+    assert_int_equal(_u32(p + 20), 4);
+    assert_int_equal(_u32(p + 24), 4);
+    assert_memory_equal(p + 28, header, 4);
+    assert_int_equal(_u32(p + 36), 0x2);
+    assert_int_equal(_u32(p + 44), 48);
+
+    remove(PCAP_FILE);
+}
+
+
+void test_trace_pcap__reopen(void** state)
+{
+    UNUSED(state);
+
+    /* A new capture file is started after the last close. */
+    int if_id = ncodec_pcap_open(PCAP_FILE, 147, "pdu");
+    assert_int_equal(if_id, 0);
+    ncodec_pcap_close();
+
+    uint8_t b[128] = {};
+    size_t  len = _read_file(PCAP_FILE, b, sizeof(b));
+    assert_int_equal(len, 28 + 32);
+    assert_int_equal(_u32(b + 28), 0x00000001);
+    assert_int_equal(_u16(b + 36), 147);
+
+    /* Unable to open the capture file. */
+    assert_int_equal(ncodec_pcap_open("missing/dir/x.pcapng", 147, NULL), -1);
+    ncodec_pcap_close(); /* No reference, no effect. */
+
+    remove(PCAP_FILE);
+}
+
+
+int run_trace_pcap_tests(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_trace_pcap__blocks),
+        cmocka_unit_test(test_trace_pcap__reopen),
+    };
+
+    return cmocka_run_group_tests_name("TRACE PCAP", tests, NULL, NULL);
+}
@@ -297,6 +297,69 @@ void test_transform__marshal_to_model(void** state)
 }
 
 
+void test_transform__timing(void** state)
+{
+    const char* inst_names[] = {
+        TRANSFORM_INST_NAME,
+    };
+    char* argv[] = {
+        (char*)"test_transform",
+        (char*)"--name=" TRANSFORM_INST_NAME,
+        (char*)"--logger=5",  // 1=debug, 5=QUIET (commit with 5!)
+        (char*)"resources/model/transform_timing.yaml",
+    };
+    SimMock* mock = *state = simmock_alloc(inst_names, ARRAY_SIZE(inst_names));
+    simmock_configure(mock, argv, ARRAY_SIZE(argv), ARRAY_SIZE(inst_names));
+    ModelMock* model = simmock_find_model(mock, TRANSFORM_INST_NAME);
+    model->vtable.step = mock_model_nop;
+    model->mi = modelc_get_model_instance(&mock->sim, model->name);
+    mock->doc_list = mock->model->mi->yaml_doc_list;
+    simmock_setup(mock, "scalar", NULL);
+
+    assert_non_null(mock->sv_signal);
+    assert_non_null(model->sv_signal);
+
+    /* Transform table, delay line sized from step size (0.0005). */
+    ModelFunction* mf = controller_get_model_function(model->mi, "model_step");
+    assert_non_null(mf);
+    ModelFunctionChannel* mfc = hashmap_get(&mf->channels, "scalar");
+    assert_non_null(mfc);
+    assert_non_null(mfc->signal_transform);
+    SignalTransform* st = mfc->signal_transform;
+    assert_double_equal(st[0].timing.state.step_size, 0.0, 0.0);
+    assert_int_equal(st[1].timing.state.delay_length, 3);
+    assert_double_equal(st[2].timing.interval, 0.002, 0.0);
+    assert_double_equal(st[3].timing.state.lag_alpha, 0.5, 0.0);
+    assert_int_equal(st[4].timing.state.delay_length, 1);
+
+    /* Input ramp: step N sets all signals to N+1. */
+    double expect[][5] = {
+        /* direct, delay, hold, lag, scaled_delay */
+        { 1.0, 1.0, 1.0, 1.0, 12.0 },
+        { 2.0, 1.0, 1.0, 1.5, 12.0 },
+        { 3.0, 1.0, 1.0, 2.25, 14.0 },
+        { 4.0, 1.0, 1.0, 3.125, 16.0 },
+        { 5.0, 2.0, 5.0, 4.0625, 18.0 },
+        { 6.0, 3.0, 5.0, 5.03125, 20.0 },
+    };
+    for (size_t step = 0; step < ARRAY_SIZE(expect); step++) {
+        for (uint32_t i = 0; i < mock->sv_signal->count; i++) {
+            mock->sv_signal->scalar[i] = step + 1;
+        }
+        assert_int_equal(simmock_step(mock, true), 0);
+        for (uint32_t i = 0; i < mock->sv_signal->count; i++) {
+            log_trace("Step %d, Index: %d (%f -> %f = %f)", step, i,
+                mock->sv_signal->scalar[i], model->sv_signal->scalar[i],
+                expect[step][i]);
+            assert_double_equal(
+                model->sv_signal->scalar[i], expect[step][i], 1e-9);
+            /* Unmodified signals are not reflected back to the vector. */
+            assert_double_equal(mock->sv_signal->scalar[i], step + 1, 0.0);
+        }
+    }
+}
+
+
 static int mock_model_marshal(
     ModelDesc* m, double* model_time, double stop_time)
 {
@@ -360,6 +423,8 @@ int run_transform_tests(void)
             test_transform__parse, test_setup_transform, test_teardown),
         cmocka_unit_test_setup_teardown(test_transform__marshal_to_model,
             test_setup_simmmock, test_teardown_simmock),
+        cmocka_unit_test_setup_teardown(test_transform__timing,
+            test_setup_simmmock, test_teardown_simmock),
         //   cmocka_unit_test_setup_teardown(test_transform__marshal_from_model,
         //   test_setup_simmmock, test_teardown_simmock),
     };
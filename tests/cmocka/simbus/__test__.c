@@ -11,6 +11,7 @@ extern uint8_t __log_level__; /* LOG_ERROR LOG_INFO LOG_DEBUG LOG_TRACE */
 
 extern int run_direct_index_tests(void);
 extern int run_map_index_tests(void);
+extern int run_loader_tests(void);
 
 
 int main()
@@ -20,5 +21,6 @@ int main()
     int rc = 0;
     rc |= run_direct_index_tests();
     rc |= run_map_index_tests();
+    rc |= run_loader_tests();
     return rc;
 }
@@ -0,0 +1,142 @@
+// Copyright 2026 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#if defined(__linux__)
+#define _GNU_SOURCE
+#endif
+#include <dlfcn.h>
+#include <dse/logger.h>
+#include <dse/testing.h>
+#include <dse/modelc/controller/model_private.h>
+#include <dse/modelc/controller/controller.h>
+#include <mock.h>
+
+
+#define UNUSED(x)    ((void)x)
+#define LOADER_MODEL "lib/loader_model.so"
+
+
+static int test_setup(void** state)
+{
+    ModelCMock* m = calloc(1, sizeof(ModelCMock));
+    m->argv = (char*[]){
+        (char*)"test_loader",
+        (char*)"--name=loader_1;loader_2;loader_3",
+        (char*)"resources/simbus/loader.yaml",
+    };
+    m->argc = 3;
+    m->model_name = "Loader";
+
+    modelc_set_default_args(&m->args, "test", 0.005, 0.005);
+    m->args.log_level = __log_level__;
+    modelc_parse_arguments(&m->args, m->argc, m->argv, m->model_name);
+    assert_int_equal(modelc_configure(&m->args, &m->sim), 0);
+
+    /* Setup the controller and load the models (i.e. not mocked). */
+    m->endpoint = endpoint_create(
+        m->sim.transport, m->sim.uri, m->sim.uid, false, m->sim.timeout);
+    controller_init(m->endpoint, &m->sim);
+    m->controller = controller_object_ref(&m->sim);
+    m->mi = m->sim.instance_list;
+    assert_int_equal(controller_load_models(&m->sim), 0);
+
+    /* Return the mock. */
+    *state = m;
+    return 0;
+}
+
+
+static int test_teardown(void** state)
+{
+    ModelCMock* m = *state;
+    if (m) {
+        mock_teardown(m);
+        free(m);
+    }
+    return 0;
+}
+
+
+static ControllerModel* _cm(ModelCMock* m, const char* name)
+{
+    ModelInstanceSpec* mi = modelc_get_model_instance(&m->sim, name);
+    assert_non_null(mi);
+    ModelInstancePrivate* mip = mi->private;
+    assert_non_null(mip->controller_model);
+    return mip->controller_model;
+}
+
+
+void test_loader__cache(void** state)
+{
+    ModelCMock*      m = *state;
+    ControllerModel* cm_1 = _cm(m, "loader_1");
+    ControllerModel* cm_2 = _cm(m, "loader_2");
+
+    /* One cached library, instances share the symbols. */
+    assert_int_equal(hashmap_number_keys(m->controller->libraries), 1);
+    assert_non_null(cm_1->handle);
+    assert_ptr_equal(cm_1->handle, cm_2->handle);
+    assert_non_null(cm_1->vtable.create);
+    assert_non_null(cm_1->vtable.step);
+    assert_null(cm_1->vtable.destroy);
+    assert_ptr_equal(cm_1->vtable.create, cm_2->vtable.create);
+    assert_ptr_equal(cm_1->vtable.step, cm_2->vtable.step);
+
+    /* Library globals are shared. */
+    int* count = dlsym(cm_1->handle, "__create_count");
+    assert_non_null(count);
+    assert_int_equal(*count, 2);
+
+    /* Each instance holds a reference, the library remains loaded when the
+    first instance releases its reference. */
+    dlclose(cm_1->handle);
+    cm_1->handle = NULL;
+    void* handle = dlopen(LOADER_MODEL, RTLD_NOW | RTLD_NOLOAD);
+    assert_non_null(handle);
+    assert_ptr_equal(handle, cm_2->handle);
+    assert_int_equal(*count, 2);
+    dlclose(handle);
+}
+
+
+void test_loader__isolate(void** state)
+{
+    ModelCMock*      m = *state;
+    ControllerModel* cm_1 = _cm(m, "loader_1");
+    ControllerModel* cm_3 = _cm(m, "loader_3");
+
+    /* Isolated instance has a private copy of the library. */
+    assert_non_null(cm_3->handle);
+    assert_ptr_not_equal(cm_3->handle, cm_1->handle);
+    assert_non_null(cm_3->vtable.create);
+    assert_ptr_not_equal(cm_3->vtable.create, cm_1->vtable.create);
+    assert_ptr_not_equal(cm_3->vtable.step, cm_1->vtable.step);
+
+    /* Library globals are not shared. */
+    int* count_1 = dlsym(cm_1->handle, "__create_count");
+    int* count_3 = dlsym(cm_3->handle, "__create_count");
+    assert_non_null(count_1);
+    assert_non_null(count_3);
+    assert_ptr_not_equal(count_1, count_3);
+    assert_int_equal(*count_1, 2);
+    assert_int_equal(*count_3, 1);
+}
+
+
+int run_loader_tests(void)
+{
+#define TGNAME "SIMBUS / LOADER"
+    void* s = test_setup;
+    void* t = test_teardown;
+
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_loader__cache, s, t),
+#if defined(__linux__)
+        cmocka_unit_test_setup_teardown(test_loader__isolate, s, t),
+#endif
+    };
+
+    return cmocka_run_group_tests_name(TGNAME, tests, NULL, NULL);
+}